@@ -1,163 +1,133 @@
-#include "AIPlayer.h"
-
-#include "Board.h"
-#include "Piece.h"
-#include "Move.h"
-#include "Typedefs.h"
-
-#include <unordered_map>
-#include <vector>
-#include <cstdlib>
-
-/**
- * Gets a move, generated by the AI.
- * @param board The board to apply the move to
- * @return Returns the board, modified according to the computer's move
- */
-void AIPlayer::getMove(Board& board)
-{
-	using namespace std;
-	typedef unordered_map<Piece*, moves_t> move_choices_t;
-	typedef unordered_map<move_ptr_t, Piece*> best_moves_t; 
-
-    // create list of possible pieces and their moves
-    move_choices_t possibleChoices;
-    
-    // loop over all peices on the board until we get one that has some moves to work with
-    // (we should get the best ones last by starting at the top - and this will come out best if we have repeats later in this function)
-    for (int x = 0; x < Board::SIZE; x++)
-    {
-        for (int y = 0; y < Board::SIZE; y++)
-        {
-            // if there's a piece here the same color as ours...
-            Piece* piece = board.getValueAt(x, y);
-            if (piece != nullptr && piece->isWhite == this->isWhite)
-            {
-                // ...find moves its
-                moves_t possibleMoves = piece->getAllPossibleMoves(board);
-                
-                // and add them with the piece to our list if there is at least one
-                if (!possibleMoves.empty())
-                    possibleChoices[piece] = possibleMoves;
-            }
-        }
-    }
-           
-    // record furthest back and furthest forward piece to alternate between 
-    // (just assign the first one in the key list for now)
-    Piece* furthestBackwardPiece = possibleChoices.begin()->first;
-    Piece* furthestForwardPiece =  possibleChoices.begin()->first;
-    
-    // iterate over our collected possibilites, looking for the best canidate 
-    // (based on this answer: http://stackoverflow.com/a/110255/3155372)
-    best_moves_t bestMovesPerPiece;
-    for (auto it : possibleChoices)
-    {
-    	Piece* piece = it.first;
-    	
-        // check if this piece is furthest back or forward (out of ones with moves)
-        int thisPieceY = piece->getCoordinates()[1];
-        if (thisPieceY > furthestForwardPiece->getCoordinates()[1])
-        {
-            // things are switched if we're the other color (furthest "forward" is furthest back)
-            if (isWhite)
-                furthestForwardPiece = piece;
-            else
-                furthestBackwardPiece = piece;
-        }
-        else if (thisPieceY < furthestBackwardPiece->getCoordinates()[1])
-        {
-            // things are switched if we're the other color (furthest "forward" is furthest back)
-            if (isWhite)
-                furthestBackwardPiece = piece;
-            else
-                furthestForwardPiece = piece;
-        }
-        
-        // for each list of possible moves, iterate over all of them and record their jump numbers
-        moves_t possibleMoves = possibleChoices[piece];
-        move_ptr_t maxJumpMove = possibleMoves[0]; // just use first for now
-        int maxJumpMoveLength = 0;
-        for (unsigned int i = 0; i < possibleMoves.size(); i++)
-        {
-            // get the jump length by the number of pieces jumped (ignore if this isn't a jump move)
-            vector<Piece*> jumpedPieces = possibleMoves[i]->getJumpedPieces(board);
-            if (!jumpedPieces.empty())
-            {
-                int jumpLength = jumpedPieces.size();
-                
-                // if it's the best so far, make it so (we are assuming the best are at the end, so drift that way by replacing similar ones as we go along)
-                if (jumpLength >= maxJumpMoveLength)
-                {
-                    maxJumpMoveLength = jumpLength;
-                    maxJumpMove = possibleMoves[i];
-                }
-            }
-        }
-        
-        // add this best move to our array for the pieces (the piece is a property of the move becasue we focus on the moves)
-        bestMovesPerPiece[maxJumpMove] = piece;
-    }
-    
-    // iterate over our best possible pieces and moves, and find the best
-    move_ptr_t absoluteBestMove = bestMovesPerPiece.begin()->first; // use first key for now
-    int absoluteBestMoveJumpLength = 0;
-    for (auto it : bestMovesPerPiece)
-    {
-    	move_ptr_t move = it.first;
-    
-        // get the length of this piece's best move's jump (it would be better to calculate this automatically with each new move, but its okay to repeat above)
-        vector<Piece*> jumpedPieces = move->getJumpedPieces(board);
-        
-        // we're only looking at jumping moves here
-        if (!jumpedPieces.empty())
-        {
-            int thisBestMoveJumpLength = jumpedPieces.size();
-        
-            // if this one is best now, make it so
-            if (thisBestMoveJumpLength >= absoluteBestMoveJumpLength)
-            {
-                absoluteBestMoveJumpLength = thisBestMoveJumpLength;
-                absoluteBestMove = move;
-            }
-        }
-    }
-    
-    // if we have a jump to do, do it...
-    if (absoluteBestMoveJumpLength > 0)
-    {
-        board.applyMoveToBoard(absoluteBestMove, bestMovesPerPiece[absoluteBestMove]);
-    }
-    else // ...otherwise, choose at 50-50 random either the furthest forward or furthest back movable piece (to balance agressiveness)
-    {
-        int randomNum = rand() & 100;
-        if (randomNum >= 50)
-        {
-        	// get the best move of the piece we want (the keys are the moves)
-            board.applyMoveToBoard(getKeyByValue(bestMovesPerPiece, furthestBackwardPiece), furthestBackwardPiece);
-        }
-        else
-        {
-            board.applyMoveToBoard(getKeyByValue(bestMovesPerPiece, furthestForwardPiece), furthestForwardPiece);
-        }  
-    }
-}
-    
-/**
- * Returns a key in a hashmap that correpsonds to the given value
- * @param map The map to search in
- * @param value The value to search for
- * @return Returns the key found in the map, may be null if not found
- */
-template <class T, class E>
-T AIPlayer::getKeyByValue(std::unordered_map<T, E> map, E value) 
-{
-    for (auto it : map) 
-    {
-        if (it.second == value)
-        {
-            return it.first;
-        }
-    }
-    return nullptr;
-}
+#include "AIPlayer.h"
+
+#include "Board.h"
+#include "Piece.h"
+#include "Move.h"
+#include "Position.h"
+#include "Search.h"
+#include "TranspositionTable.h"
+#include "Tablebase.h"
+#include "OpeningBook.h"
+#include "Typedefs.h"
+
+const char* const AIPlayer::DEFAULT_TABLEBASE_DIRECTORY = "tablebases";
+const char* const AIPlayer::DEFAULT_BOOK_FILE = "openings.book";
+
+/**
+ * Stops the search the AI is running for its move (from another thread), so it plays the best move
+ * it has found so far at once. Does nothing if it isn't searching.
+ */
+void AIPlayer::stop()
+{
+    std::lock_guard<std::mutex> lock(searchLock);
+    if (search != nullptr)
+        search->stop();
+}
+
+/**
+ * Gets a move, generated by the AI.
+ * @param board The board to apply the move to
+ * @return Returns the board, modified according to the computer's move
+ */
+void AIPlayer::getMove(Board& board)
+{
+    // search from our point of view, whatever the board thinks
+    Position position = board.getPosition();
+    position.setWhiteToMove(isWhite);
+
+    // if the opponent played the reply we pondered on, that search already has a head start
+    Move bookMove;
+    if (stopPondering(&position))
+        lastResult = ponderResult;
+    // while the game is still in the book, just play one of its moves
+    else if (book.probe(position, random(), bookMove))
+    {
+        lastResult = SearchResult();
+        lastResult.bestMove = bookMove;
+        lastResult.pv.push_back(bookMove);
+    }
+    else
+    {
+        // (where stop can find it, until it is done)
+        Search current(table, threads, tablebase.get());
+        {
+            std::lock_guard<std::mutex> lock(searchLock);
+            search = &current;
+        }
+        lastResult = current.run(position, limits);
+        {
+            std::lock_guard<std::mutex> lock(searchLock);
+            search = nullptr;
+        }
+    }
+
+    // there's nothing to do if we have no moves (the game should be over by now anyway)
+    if (lastResult.bestMove.isNull())
+        return;
+
+    board.applyMoveToBoard(lastResult.bestMove);
+
+    startPondering(board);
+}
+
+/**
+ * Starts pondering, if it is wanted, on the position after the reply expected to the last move.
+ * @param board The board after the last move
+ */
+void AIPlayer::startPondering(const Board& board)
+{
+    // the reply is only known if the search saw past our move (not for a book move)
+    if (!ponder || lastResult.pv.size() < 2)
+        return;
+
+    ponderPosition = board.getPosition();
+    ponderPosition.setWhiteToMove(!isWhite);
+    ponderPosition.applyMove(lastResult.pv[1]);
+
+    // (it searches without limits until the reply is known, when it is given the limits set for that move)
+    ponderSearch.reset(new Search(table, threads, tablebase.get()));
+    ponderSearch->setPondering(true);
+    Search* pondering = ponderSearch.get();
+    ponderThread = std::thread([this, pondering]()
+    {
+        ponderResult = pondering->run(ponderPosition, SearchLimits());
+    });
+}
+
+/**
+ * Stops pondering, if it is, and waits for it to finish.
+ * @param position The position to move in, or null to throw away what was pondered
+ * @return Returns true if the position was the one pondered, in which case the search went on
+ * until the current limits were reached (counting its time from now) and ponderResult has its result
+ */
+bool AIPlayer::stopPondering(const Position* position)
+{
+    if (!ponderSearch)
+        return false;
+
+    bool hit = position != nullptr && position->isWhiteToMove() == ponderPosition.isWhiteToMove() &&
+               position->getPieces(true) == ponderPosition.getPieces(true) &&
+               position->getPieces(false) == ponderPosition.getPieces(false) &&
+               position->getKings() == ponderPosition.getKings();
+
+    // a hit carries on searching with this move's limits as if it had just started (where stop can find it),
+    // and a miss stops at once
+    if (hit)
+    {
+        {
+            std::lock_guard<std::mutex> lock(searchLock);
+            search = ponderSearch.get();
+        }
+        ponderSearch->ponderHit(limits);
+    }
+    else
+        ponderSearch->stop();
+
+    ponderThread.join();
+    {
+        std::lock_guard<std::mutex> lock(searchLock);
+        search = nullptr;
+    }
+    ponderSearch.reset();
+    return hit;
+}
@@ -1,46 +1,143 @@
-#ifndef AI_PLAYER_H
-#define AI_PLAYER_H
-
-#include "Player.h"
-
-#include <unordered_map>
-
-class Board;
-
-/**
- * Responsible for the checkers artifical intelligence.
- * 
- * @author Mckenna Cisler 
- * @version 5.18.2016
- */
-class AIPlayer : public Player
-{
-    private:
-    	bool isWhite;
-    	
-    	/**
-		 * Returns a key in a hashmap that correpsonds to the given value
-		 * @param map The map to search in
-		 * @param value The value to search for
-
-		 * @return Returns the key found in the map, may be null if not found
-		 */
-		template <class T, class E>
-		T getKeyByValue(std::unordered_map<T, E> map, E value);
-    
-    public:
-		/**
-		 * Constructor for the AIPlayer.
- 		 * @param isWhite Used to specify if this "player" is black or white.
-		 */
-		AIPlayer(bool isWhite) : isWhite(isWhite) {};
-
-		/**
-		 * Gets a move, generated by the AI.
-		 * @param board The board to apply the move to
-		 * @return Returns the board, modified according to the computer's move
-		 */
-		virtual void getMove(Board& board);
-};
-
-#endif
+#ifndef AI_PLAYER_H
+#define AI_PLAYER_H
+
+#include "Player.h"
+#include "Search.h"
+#include "TranspositionTable.h"
+#include "Tablebase.h"
+#include "OpeningBook.h"
+
+#include <string>
+#include <memory>
+#include <random>
+#include <mutex>
+#include <thread>
+
+class Board;
+
+/**
+ * Responsible for the checkers artifical intelligence.
+ *
+ * It can ponder: once it has moved, it goes on searching in the background on the position after the reply
+ * it expects (the next move of its principal variation), until its next turn. If the reply was the expected one,
+ * that search simply carries on, already well under way; if not, it is thrown away.
+ * 
+ * @author Mckenna Cisler 
+ * @version 10.16.2026
+ */
+class AIPlayer : public Player
+{
+    private:
+    	bool isWhite;
+    	SearchLimits limits;
+    	SearchResult lastResult;
+    	TranspositionTable table;
+    	int threads;
+    	std::unique_ptr<Tablebase> tablebase;
+    	OpeningBook book;
+    	std::mt19937_64 random; // chooses between the book's moves
+    	std::mutex searchLock;  // guards search
+    	Search* search;         // the search getMove is running, if it is
+    	bool ponder;
+    	std::unique_ptr<Search> ponderSearch; // the search running between moves, if there is one
+    	std::thread ponderThread;             // which runs it
+    	Position ponderPosition;              // the position it is searching
+    	SearchResult ponderResult;
+
+		/**
+		 * Starts pondering, if it is wanted, on the position after the reply expected to the last move.
+		 * @param board The board after the last move
+		 */
+		void startPondering(const Board& board);
+
+		/**
+		 * Stops pondering, if it is, and waits for it to finish.
+		 * @param position The position to move in, or null to throw away what was pondered
+		 * @return Returns true if the position was the one pondered, in which case the search went on
+		 * until the current limits were reached (counting its time from now) and ponderResult has its result
+		 */
+		bool stopPondering(const Position* position = nullptr);
+    
+    public:
+    	// the default memory budget of the transposition table, in megabytes
+    	const static size_t DEFAULT_HASH_SIZE = 16;
+
+    	// where the endgame tables are looked for by default (see the tbgen tool)
+    	static const char* const DEFAULT_TABLEBASE_DIRECTORY;
+
+    	// where the opening book is looked for by default (see the bookgen tool)
+    	static const char* const DEFAULT_BOOK_FILE;
+
+		/**
+		 * Constructor for the AIPlayer.
+ 		 * @param isWhite Used to specify if this "player" is black or white.
+		 */
+		AIPlayer(bool isWhite) : isWhite(isWhite), table(DEFAULT_HASH_SIZE), threads(1),
+			tablebase(new Tablebase(DEFAULT_TABLEBASE_DIRECTORY)), random(std::random_device()()), search(nullptr),
+			ponder(false)
+		{ book.open(DEFAULT_BOOK_FILE); }
+
+		virtual ~AIPlayer() { stopPondering(); }
+
+		/**
+		 * Sets how far the AI searches when deciding on a move.
+		 * @param limits The depth, node and time limits to use for every search (with a clock, the time left
+		 * should be set before each move)
+		 */
+		void setSearchLimits(const SearchLimits& limits) { this->limits = limits; }
+
+		/**
+		 * Sets how much memory the AI may use to remember positions it has searched.
+		 * (This clears everything it has remembered so far)
+		 * @param megabytes The size of the transposition table
+		 */
+		void setHashSize(size_t megabytes) { stopPondering(); table.resize(megabytes); }
+
+		/**
+		 * Sets how many threads the AI searches with.
+		 * @param threads The number of threads (at least one)
+		 */
+		void setThreads(int threads) { this->threads = threads; }
+
+		/**
+		 * Sets where the AI looks for endgame tables (which are only read once they are needed).
+		 * @param directory The directory the tables were generated in (empty to not use any)
+		 */
+		void setTablebaseDirectory(const std::string& directory)
+		{ stopPondering(); tablebase.reset(directory.empty() ? nullptr : new Tablebase(directory)); }
+
+		/**
+		 * Sets the opening book the AI plays from while the game is still in it.
+		 * @param path The book file (empty to not use any)
+		 * @return Returns true if the book could be opened (or none was wanted)
+		 */
+		bool setBookFile(const std::string& path)
+		{ return book.open(path) || path.empty(); }
+
+		/**
+		 * Sets whether the AI ponders on the opponent's time (using as many threads as it searches with).
+		 * This is only worth it when the opponent isn't using the same processor, like a person.
+		 * @param ponder Whether to ponder
+		 */
+		void setPondering(bool ponder) { this->ponder = ponder; if (!ponder) stopPondering(); }
+
+		/**
+		 * @return Returns the result of the last search (including its principal variation and statistics)
+		 */
+		const SearchResult& getLastResult() const { return lastResult; }
+
+		/**
+		 * Stops the search the AI is running for its move (from another thread), so it plays the best move
+		 * it has found so far at once. Does nothing if it isn't searching.
+		 */
+		void stop();
+
+		/**
+		 * Gets a move, generated by the AI.
+		 * @param board The board to apply the move to
+		 * @return Returns the board, modified according to the computer's move
+		 */
+		virtual void getMove(Board& board);
+};
+
+#endif
@@ -0,0 +1,51 @@
+#include "Arena.h"
+
+#include <cstdint>
+#include <new>
+
+/**
+ * Responsible for allocating the arena's memory.
+ * @param bytes The most the arena will ever need to hold at once
+ */
+Arena::Arena(size_t bytes) : capacity(0), used(0), peak(0)
+{
+    reserve(bytes);
+}
+
+/**
+ * Makes sure the arena can hold at least the given number of bytes, reallocating it if not.
+ * (Must only be called when nothing is allocated in it)
+ * @param bytes The most the arena will ever need to hold at once
+ */
+void Arena::reserve(size_t bytes)
+{
+    if (bytes <= capacity)
+        return;
+
+    memory.reset(new char[bytes]);
+    capacity = bytes;
+    used = 0;
+}
+
+/**
+ * Allocates memory from the arena.
+ * @param bytes The number of bytes needed
+ * @param alignment The alignment needed (a power of two)
+ * @return Returns the memory (throwing std::bad_alloc if the arena is full)
+ */
+void* Arena::allocate(size_t bytes, size_t alignment)
+{
+    // round the next free byte up to the alignment (by its actual address, since the block itself
+    // is only as aligned as new makes it)
+    uintptr_t base = reinterpret_cast<uintptr_t>(memory.get());
+    uintptr_t start = (base + used + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    size_t end = start - base + bytes;
+
+    if (end > capacity)
+        throw std::bad_alloc();
+
+    used = end;
+    if (used > peak)
+        peak = used;
+    return reinterpret_cast<void*>(start);
+}
@@ -0,0 +1,94 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+/**
+ * A block of memory handed out by just moving a pointer along it ("bump" allocation),
+ * for scratch data that is only needed for a short, nested stretch of time, such as the
+ * moves and lines of one node of a search. Nothing is freed on its own: instead everything
+ * allocated since a mark is released at once by moving the pointer back to it.
+ *
+ * Only types that don't need destroying can be created in an arena (moves, move lists and so on).
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+class Arena
+{
+	public:
+		/**
+		 * Releases everything allocated in an arena during its lifetime (so one can be put at the
+		 * top of a function to free all of that function's scratch data when it returns).
+		 */
+		class Scope
+		{
+			public:
+				Scope(Arena& arena) : arena(arena), mark(arena.getMark()) {};
+				~Scope() { arena.release(mark); }
+
+			private:
+				Arena& arena;
+				const size_t mark;
+		};
+
+		/**
+		 * Responsible for allocating the arena's memory.
+		 * @param bytes The most the arena will ever need to hold at once
+		 */
+		Arena(size_t bytes = 0);
+
+		/**
+		 * Makes sure the arena can hold at least the given number of bytes, reallocating it if not.
+		 * (Must only be called when nothing is allocated in it)
+		 * @param bytes The most the arena will ever need to hold at once
+		 */
+		void reserve(size_t bytes);
+
+		/**
+		 * Allocates memory from the arena.
+		 * @param bytes The number of bytes needed
+		 * @param alignment The alignment needed (a power of two)
+		 * @return Returns the memory (throwing std::bad_alloc if the arena is full)
+		 */
+		void* allocate(size_t bytes, size_t alignment);
+
+		/**
+		 * Creates an object in the arena, which lasts until it is released.
+		 * (It is default-initialized, so like a local variable, plain data in it is left unset)
+		 * @return Returns the new object
+		 */
+		template <typename T>
+		T& create()
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "arena objects are never destroyed");
+			return *new (allocate(sizeof(T), alignof(T))) T;
+		}
+
+		/**
+		 * @return Returns a mark of everything allocated so far, for release
+		 */
+		size_t getMark() const { return used; }
+
+		/**
+		 * Frees everything allocated since the given mark was taken.
+		 * @param mark A mark from getMark
+		 */
+		void release(size_t mark) { used = mark; }
+
+		/**
+		 * @return Returns the most bytes that have been in use at once
+		 */
+		size_t getPeak() const { return peak; }
+
+	private:
+		std::unique_ptr<char[]> memory;
+		size_t capacity;
+		size_t used;
+		size_t peak;
+};
+
+#endif
@@ -0,0 +1,268 @@
+#include "EngineProtocol.h"
+
+#include "AIPlayer.h"
+#include "Board.h"
+#include "Move.h"
+#include "Typedefs.h"
+
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+
+/**
+ * @return Returns the words of a line (split on whitespace)
+ */
+static std::vector<std::string> splitWords(const std::string& line)
+{
+    std::istringstream stream(line);
+    std::vector<std::string> words;
+    std::string word;
+    while (stream >> word)
+        words.push_back(word);
+    return words;
+}
+
+/**
+ * Responsible for setting up the engine, at the starting position.
+ * @param in Where the commands are read from
+ * @param out Where the replies are written to
+ */
+EngineProtocol::EngineProtocol(std::istream& in, std::ostream& out) :
+    in(in), out(out), table(AIPlayer::DEFAULT_HASH_SIZE), threads(1),
+    tablebase(new Tablebase(AIPlayer::DEFAULT_TABLEBASE_DIRECTORY)), random(std::random_device()())
+{
+    book.open(AIPlayer::DEFAULT_BOOK_FILE);
+
+    Board board;
+    position = board.getPosition();
+}
+
+/**
+ * Stops any search that is still running.
+ */
+EngineProtocol::~EngineProtocol()
+{
+    stopSearch();
+}
+
+/**
+ * Reads and handles commands until "quit" or the end of the input
+ * (at the end of the input, any search still running is left to finish).
+ */
+void EngineProtocol::run()
+{
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (!handle(line))
+        {
+            stopSearch();
+            return;
+        }
+    }
+
+    // at the end of the input (rather than a quit), let the last search finish instead of cutting it short
+    if (searchThread.joinable())
+        searchThread.join();
+    search.reset();
+}
+
+/**
+ * Handles a single command.
+ * @param line The command
+ * @return Returns false if the command was to quit
+ */
+bool EngineProtocol::handle(const std::string& line)
+{
+    std::vector<std::string> words = splitWords(line);
+    if (words.empty())
+        return true;
+
+    std::string command = words[0];
+    words.erase(words.begin());
+
+    if (command == "quit")
+        return false;
+    else if (command == "isready")
+        send("readyok");
+    else if (command == "stop")
+        stopSearch();
+    else if (command == "go")
+        go(words);
+    else if (command == "position")
+    {
+        stopSearch();
+        if (!setPosition(words))
+            send("info string invalid position: " + line);
+    }
+    else if (command == "newgame")
+    {
+        stopSearch();
+        table.clear();
+    }
+    else if (command == "setoption" && words.size() >= 2)
+    {
+        stopSearch();
+        if (words[0] == "hash")
+            table.resize(std::strtoul(words[1].c_str(), nullptr, 10));
+        else if (words[0] == "threads")
+            threads = std::max(1, std::atoi(words[1].c_str()));
+        else if (words[0] == "book")
+            book.open(words[1] == "none" ? "" : words[1]);
+        else if (words[0] == "tablebases")
+            tablebase.reset(words[1] == "none" ? nullptr : new Tablebase(words[1]));
+        else
+            send("info string unknown option: " + words[0]);
+    }
+    else
+        send("info string unknown command: " + line);
+
+    return true;
+}
+
+/**
+ * Sets up the position from the words of a "position" command.
+ * @param words The words after "position"
+ * @return Returns false (leaving the position as it was) if the position or a move isn't valid
+ */
+bool EngineProtocol::setPosition(const std::vector<std::string>& words)
+{
+    Position newPosition;
+    unsigned int i = 1;
+    if (!words.empty() && words[0] == "startpos")
+        newPosition = Board().getPosition();
+    else if (words.size() >= 2 && words[0] == "fen")
+    {
+        // the FEN uses the usual checkers colors (like PDN), so swap them for ours
+        std::string fen = words[1];
+        for (size_t j = 0; j < fen.size(); j++)
+            fen[j] = fen[j] == 'W' ? 'B' : fen[j] == 'B' ? 'W' : fen[j];
+        if (!newPosition.setFromFen(fen.c_str(), fen.size()))
+            return false;
+        i = 2;
+    }
+    else
+        return false;
+
+    if (i < words.size() && words[i] == "moves")
+        i++;
+    for (; i < words.size(); i++)
+    {
+        Move move;
+        if (!newPosition.findMove(words[i], move))
+            return false;
+        newPosition.applyMove(move);
+    }
+
+    position = newPosition;
+    return true;
+}
+
+/**
+ * Starts searching in the background, with the limits in the words of a "go" command.
+ * @param words The words after "go"
+ */
+void EngineProtocol::go(const std::vector<std::string>& words)
+{
+    stopSearch();
+
+    // any limit other than depth searches as deep as it takes to reach it
+    SearchLimits limits;
+    bool depthGiven = false, otherGiven = false;
+    for (unsigned int i = 0; i < words.size(); i++)
+    {
+        bool hasValue = i + 1 < words.size();
+        if (words[i] == "depth" && hasValue)
+        {
+            limits.depth = std::atoi(words[++i].c_str());
+            depthGiven = true;
+        }
+        else if (words[i] == "nodes" && hasValue)
+        {
+            limits.nodes = std::atoll(words[++i].c_str());
+            otherGiven = true;
+        }
+        else if (words[i] == "movetime" && hasValue)
+        {
+            limits.movetime = std::atoi(words[++i].c_str());
+            otherGiven = true;
+        }
+        else if ((words[i] == "wtime" || words[i] == "btime" || words[i] == "winc" || words[i] == "binc") && hasValue)
+        {
+            // only the clock of the side to move matters (where the protocol's Black is our White)
+            const std::string& name = words[i];
+            int milliseconds = std::atoi(words[++i].c_str());
+            otherGiven = true;
+            if ((name[0] == 'b') != position.isWhiteToMove())
+                continue;
+            if (name[1] == 't')
+                limits.time = milliseconds;
+            else
+                limits.increment = milliseconds;
+        }
+        else if (words[i] == "movestogo" && hasValue)
+            limits.movesToGo = std::atoi(words[++i].c_str());
+        else if (words[i] == "infinite")
+            otherGiven = true;
+    }
+    if (otherGiven && !depthGiven)
+        limits.depth = 0;
+
+    // while the game is still in the book, there's nothing to search
+    Move bookMove;
+    if (book.probe(position, random(), bookMove))
+    {
+        send("info string book move");
+        send("bestmove " + bookMove.getNotation());
+        return;
+    }
+
+    search.reset(new Search(table, threads, tablebase.get()));
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    search->setIterationCallback([this, start](const SearchResult& result)
+    {
+        long long milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+
+        std::ostringstream info;
+        info << "info depth " << result.depth << " score " << result.score << " nodes " << result.nodes
+             << " nps " << (milliseconds > 0 ? result.nodes * 1000 / milliseconds : result.nodes)
+             << " time " << milliseconds << " pv";
+        for (unsigned int i = 0; i < result.pv.size(); i++)
+            info << ' ' << result.pv[i].getNotation();
+        send(info.str());
+    });
+
+    Search* current = search.get();
+    Position root = position;
+    searchThread = std::thread([this, current, root, limits]()
+    {
+        // (even a search stopped before its first iteration finished gives some move)
+        SearchResult result = current->run(root, limits);
+        send("info string stats " + result.stats.toJson());
+        send("bestmove " + (result.bestMove.isNull() ? std::string("none") : result.bestMove.getNotation()));
+    });
+}
+
+/**
+ * Stops the search, if one is running, and waits for it to reply with its move.
+ */
+void EngineProtocol::stopSearch()
+{
+    if (search)
+        search->stop();
+    if (searchThread.joinable())
+        searchThread.join();
+    search.reset();
+}
+
+/**
+ * Writes a line of reply, all at once.
+ * @param line The line (without the newline)
+ */
+void EngineProtocol::send(const std::string& line)
+{
+    std::lock_guard<std::mutex> lock(output);
+    out << line << std::endl;
+}
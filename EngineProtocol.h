@@ -0,0 +1,114 @@
+#ifndef ENGINE_PROTOCOL_H
+#define ENGINE_PROTOCOL_H
+
+#include "Position.h"
+#include "Search.h"
+#include "TranspositionTable.h"
+#include "Tablebase.h"
+#include "OpeningBook.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <random>
+#include <mutex>
+#include <thread>
+#include <iostream>
+
+/**
+ * Responsible for running the engine as a long-lived process that other programs (such as tournament
+ * managers) drive with a line-based text protocol over stdin and stdout, instead of the interactive game.
+ *
+ * Colors follow the usual checkers convention, as in PDN: Black moves first, from squares 1-12 (our White),
+ * so the starting position in FEN is B:W21-32:B1-12 and btime/binc are the first mover's clock.
+ *
+ * The commands are:
+ *   isready                             replies "readyok" (once any earlier command has been handled)
+ *   newgame                             forgets everything learned from earlier games
+ *   setoption <name> <value>            sets hash (megabytes), threads, book (a file) or tablebases (a directory)
+ *   position startpos [moves <moves>]   sets up the starting position and plays the moves (like 9-13 or 9x18) on it
+ *   position fen <fen> [moves <moves>]  sets up a position given in FEN (see Position::setFromFen, but with the colors
+ *                                       swapped as above) and plays the moves
+ *   go [depth <plies>] [nodes <count>] [movetime <milliseconds>] [infinite]
+ *      [wtime <milliseconds>] [btime <milliseconds>] [winc <milliseconds>] [binc <milliseconds>] [movestogo <moves>]
+ *                                       searches the position in the background, for as long as its clock
+ *                                       (White's or Black's time left and increment) can afford if one is given,
+ *                                       reporting each iteration as
+ *                                       "info depth <plies> score <score> nodes <count> nps <count> time <milliseconds>
+ *                                       pv <moves>", then "info string stats <json>" with what it did (see SearchStats),
+ *                                       and replies "bestmove <move>" (or "bestmove none")
+ *   stop                                stops the search, which then replies with its best move so far
+ *   quit                                stops any search and exits
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+class EngineProtocol
+{
+	public:
+		/**
+		 * Responsible for setting up the engine, at the starting position.
+		 * @param in Where the commands are read from
+		 * @param out Where the replies are written to
+		 */
+		EngineProtocol(std::istream& in, std::ostream& out);
+
+		/**
+		 * Stops any search that is still running.
+		 */
+		~EngineProtocol();
+
+		/**
+		 * Reads and handles commands until "quit" or the end of the input
+		 * (at the end of the input, any search still running is left to finish).
+		 */
+		void run();
+
+	private:
+		std::istream& in;
+		std::ostream& out;
+		std::mutex output; // the search thread and the command loop both write replies
+
+		TranspositionTable table;
+		int threads;
+		std::unique_ptr<Tablebase> tablebase;
+		OpeningBook book;
+		std::mt19937_64 random; // chooses between the book's moves
+
+		Position position;
+		std::unique_ptr<Search> search; // the search running in the background, if any
+		std::thread searchThread;
+
+		/**
+		 * Handles a single command.
+		 * @param line The command
+		 * @return Returns false if the command was to quit
+		 */
+		bool handle(const std::string& line);
+
+		/**
+		 * Sets up the position from the words of a "position" command.
+		 * @param words The words after "position"
+		 * @return Returns false (leaving the position as it was) if the position or a move isn't valid
+		 */
+		bool setPosition(const std::vector<std::string>& words);
+
+		/**
+		 * Starts searching in the background, with the limits in the words of a "go" command.
+		 * @param words The words after "go"
+		 */
+		void go(const std::vector<std::string>& words);
+
+		/**
+		 * Stops the search, if one is running, and waits for it to reply with its move.
+		 */
+		void stopSearch();
+
+		/**
+		 * Writes a line of reply, all at once.
+		 * @param line The line (without the newline)
+		 */
+		void send(const std::string& line);
+};
+
+#endif
@@ -0,0 +1,244 @@
+#include "Evaluator.h"
+
+#include "Board.h"
+#include "Position.h"
+#include "Typedefs.h"
+
+#include <fstream>
+#include <sstream>
+
+// the back rank of each side (the row its men start on and the other side is crowned on)
+static const bitboard_t WHITE_BACK_RANK = 0x0000000F;
+static const bitboard_t BLACK_BACK_RANK = 0xF0000000;
+
+// the rows a man of each side has to be on to be looked at as a runaway (the last three before crowning)
+static const bitboard_t WHITE_RUNAWAY_ROWS = 0x0FFF0000;
+static const bitboard_t BLACK_RUNAWAY_ROWS = 0x0000FFF0;
+
+const int Evaluator::DEFAULT_WEIGHTS[FEATURES] = { 100, 130, 2, 4, 3, 5, 2, 30 };
+
+const char* const Evaluator::FEATURE_NAMES[FEATURES] =
+    { "men", "kings", "advancement", "backrank", "center", "kingcenter", "mobility", "runaways" };
+
+const char* const Evaluator::DEFAULT_WEIGHTS_FILE = "eval.weights";
+
+int Evaluator::weights[FEATURES];
+int Evaluator::pieceValues[2][2][32];
+
+// every square ahead of a man (by color, then square) which it could pass through on its way to
+// being crowned, so that if none of them hold a piece nothing can stop it
+static bitboard_t runwayMasks[2][32];
+
+/**
+ * @return Returns a bitboard of the eight squares in the middle of the board
+ */
+static bitboard_t getCenterSquares()
+{
+    bitboard_t center = 0;
+    for (int square = 0; square < Position::SQUARES; square++)
+    {
+        coords_t coords = Position::getCoordsFromSquare(square);
+        if (coords[0] >= 2 && coords[0] <= Board::SIZE - 3 && coords[1] >= 2 && coords[1] <= Board::SIZE - 3)
+            center |= 1u << square;
+    }
+    return center;
+}
+
+static const bitboard_t CENTER_SQUARES = getCenterSquares();
+
+/**
+ * Fills in the runway of every square, and the piece values for the default weights, at startup.
+ */
+static bool setUpTables()
+{
+    for (int square = 0; square < Position::SQUARES; square++)
+    {
+        for (int side = 0; side < 2; side++)
+        {
+            int left = side == 0 ? Position::DOWN_LEFT : Position::UP_LEFT;
+            int right = side == 0 ? Position::DOWN_RIGHT : Position::UP_RIGHT;
+
+            // spread out diagonally forward one row at a time, until falling off the far side
+            bitboard_t front = 1u << square;
+            runwayMasks[side][square] = 0;
+            while (front)
+            {
+                front = Position::shift(front, left) | Position::shift(front, right);
+                runwayMasks[side][square] |= front;
+            }
+        }
+    }
+
+    Evaluator::setWeights(Evaluator::DEFAULT_WEIGHTS);
+    return true;
+}
+
+static const bool tablesSetUp = setUpTables();
+
+/**
+ * @return Returns the number of runaway men of a side (see Feature)
+ * @param position The position to look at
+ * @param isWhite The side to look at
+ */
+static int countRunaways(const Position& position, bool isWhite)
+{
+    // only men close to being crowned are worth checking, which usually leaves none
+    bitboard_t men = position.getPieces(isWhite) & ~position.getKings() &
+                     (isWhite ? WHITE_RUNAWAY_ROWS : BLACK_RUNAWAY_ROWS);
+    bitboard_t occupied = ~position.getEmptySquares();
+
+    int runaways = 0;
+    while (men)
+    {
+        if (!(runwayMasks[isWhite ? 0 : 1][Position::popSquare(men)] & occupied))
+            runaways++;
+    }
+    return runaways;
+}
+
+/**
+ * @return Returns the number of pieces of a side with a move
+ * @param position The position to look at
+ * @param isWhite The side to look at
+ */
+static int countMobility(const Position& position, bool isWhite)
+{
+    return Position::countSquares(position.getMovablePieces(isWhite) | position.getJumpingPieces(isWhite));
+}
+
+/**
+ * @return Returns a static estimate of the position for the side to move
+ * @param position The position to evaluate
+ */
+int Evaluator::evaluate(const Position& position)
+{
+    // everything that depends only on where the pieces stand is already added up
+    int score = position.getPieceScore();
+
+    score += weights[MOBILITY] * (countMobility(position, true) - countMobility(position, false));
+    score += weights[RUNAWAYS] * (countRunaways(position, true) - countRunaways(position, false));
+
+    return position.isWhiteToMove() ? score : -score;
+}
+
+/**
+ * Counts every feature of a position from scratch (evaluate is the sum of these times their weights).
+ * @param position The position to look at
+ * @param features Filled with the count of each Feature, for White minus Black
+ */
+void Evaluator::getFeatures(const Position& position, int features[FEATURES])
+{
+    for (int feature = 0; feature < FEATURES; feature++)
+        features[feature] = 0;
+
+    for (int side = 0; side < 2; side++)
+    {
+        bool isWhite = side == 0;
+        int sign = isWhite ? 1 : -1;
+        bitboard_t pieces = position.getPieces(isWhite);
+        bitboard_t kings = pieces & position.getKings();
+        bitboard_t men = pieces & ~kings;
+
+        features[MEN] += sign * Position::countSquares(men);
+        features[KINGS] += sign * Position::countSquares(kings);
+        features[BACK_RANK] += sign * Position::countSquares(men & (isWhite ? WHITE_BACK_RANK : BLACK_BACK_RANK));
+        features[CENTER] += sign * Position::countSquares(men & CENTER_SQUARES);
+        features[KING_CENTER] += sign * Position::countSquares(kings & CENTER_SQUARES);
+        features[MOBILITY] += sign * countMobility(position, isWhite);
+        features[RUNAWAYS] += sign * countRunaways(position, isWhite);
+
+        // white moves down the board, and black up it
+        while (men)
+        {
+            int row = Position::popSquare(men) / (Board::SIZE / 2);
+            features[ADVANCEMENT] += sign * (isWhite ? row : Board::SIZE - 1 - row);
+        }
+    }
+}
+
+/**
+ * Sets the weight of every feature. Positions set up before this keep the piece scores they had,
+ * so this should only be done at startup, before any are.
+ * @param newWeights The weight of each Feature
+ */
+void Evaluator::setWeights(const int newWeights[FEATURES])
+{
+    for (int feature = 0; feature < FEATURES; feature++)
+        weights[feature] = newWeights[feature];
+
+    for (int square = 0; square < Position::SQUARES; square++)
+    {
+        bitboard_t bit = 1u << square;
+        int row = square / (Board::SIZE / 2);
+        int center = (bit & CENTER_SQUARES) ? 1 : 0;
+
+        for (int side = 0; side < 2; side++)
+        {
+            bool isWhite = side == 0;
+            int advancement = isWhite ? row : Board::SIZE - 1 - row;
+            int backRank = (bit & (isWhite ? WHITE_BACK_RANK : BLACK_BACK_RANK)) ? 1 : 0;
+
+            int man = weights[MEN] + weights[ADVANCEMENT] * advancement + weights[BACK_RANK] * backRank +
+                      weights[CENTER] * center;
+            int king = weights[KINGS] + weights[KING_CENTER] * center;
+
+            // black's pieces count against white
+            pieceValues[side][0][square] = isWhite ? man : -man;
+            pieceValues[side][1][square] = isWhite ? king : -king;
+        }
+    }
+}
+
+/**
+ * Sets the weights from a file with a feature name and weight on each line, like "kings 130"
+ * (features left out keep their weight, and lines starting with # are ignored).
+ * Like setWeights, this should only be done at startup.
+ * @param path The file
+ * @return Returns false (leaving the weights unchanged) if the file can't be read or isn't valid
+ */
+bool Evaluator::loadWeights(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file)
+        return false;
+
+    int newWeights[FEATURES];
+    for (int feature = 0; feature < FEATURES; feature++)
+        newWeights[feature] = weights[feature];
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream words(line);
+        std::string name;
+        int weight;
+        if (!(words >> name) || name[0] == '#')
+            continue;
+        if (!(words >> weight))
+            return false;
+
+        int feature = 0;
+        while (feature < FEATURES && name != FEATURE_NAMES[feature])
+            feature++;
+        if (feature == FEATURES)
+            return false;
+        newWeights[feature] = weight;
+    }
+
+    setWeights(newWeights);
+    return true;
+}
+
+/**
+ * Writes the weights to a file that loadWeights can read.
+ * @param path The file
+ * @return Returns false if the file couldn't be written
+ */
+bool Evaluator::saveWeights(const std::string& path)
+{
+    std::ofstream file(path);
+    file << "# evaluation weights (see Evaluator.h)\n";
+    for (int feature = 0; feature < FEATURES; feature++)
+        file << FEATURE_NAMES[feature] << ' ' << weights[feature] << '\n';
+    return (bool)file;
+}
@@ -0,0 +1,108 @@
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+
+#include "Typedefs.h"
+
+#include <string>
+
+class Position;
+
+/**
+ * Estimates how good a position is without searching it, as a weighted sum of features:
+ * material (men and kings), how far men have advanced, men guarding their own back rank,
+ * pieces in the center, mobility, and men with a clear run to being crowned.
+ *
+ * Everything that depends only on which piece stands on which square (all but mobility and runaway
+ * men) is folded into a single value per piece and square, which Position adds and subtracts as
+ * pieces move (see Position::getPieceScore). So an evaluation is that running total plus a few shifts,
+ * instead of a scan of the board.
+ *
+ * The weights can be tuned to games (see the tune tool), which writes them to a file read at startup.
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+class Evaluator
+{
+	public:
+		// the features a position is scored on, each counted for White minus Black
+		enum Feature
+		{
+			MEN = 0,         // men on the board
+			KINGS,           // kings on the board
+			ADVANCEMENT,     // rows advanced by all men together
+			BACK_RANK,       // men still on their own back rank, guarding it from being crowned on
+			CENTER,          // men on the eight center squares
+			KING_CENTER,     // kings on the eight center squares
+			MOBILITY,        // pieces with a move
+			RUNAWAYS,        // men that nothing stands between and being crowned
+			FEATURES         // (the number of features)
+		};
+
+		// the weight of each feature unless others are set
+		static const int DEFAULT_WEIGHTS[FEATURES];
+
+		// the name of each feature (such as in a file of weights)
+		static const char* const FEATURE_NAMES[FEATURES];
+
+		// where the weights are looked for at startup (see the tune tool)
+		static const char* const DEFAULT_WEIGHTS_FILE;
+
+		/**
+		 * @return Returns a static estimate of the position for the side to move
+		 * @param position The position to evaluate
+		 */
+		static int evaluate(const Position& position);
+
+		/**
+		 * Counts every feature of a position from scratch (evaluate is the sum of these times their weights).
+		 * @param position The position to look at
+		 * @param features Filled with the count of each Feature, for White minus Black
+		 */
+		static void getFeatures(const Position& position, int features[FEATURES]);
+
+		/**
+		 * @return Returns the value of a piece standing on a square, from White's point of view
+		 * (the sum of the weights of every Feature that depends only on the piece and square)
+		 * @param square The square number, 0-31
+		 * @param isWhite The color of the piece
+		 * @param isKing Whether the piece is a king
+		 */
+		static int getPieceValue(int square, bool isWhite, bool isKing)
+		{ return pieceValues[isWhite ? 0 : 1][isKing ? 1 : 0][square]; }
+
+		/**
+		 * @return Returns the weight of a feature
+		 * @param feature The Feature
+		 */
+		static int getWeight(int feature) { return weights[feature]; }
+
+		/**
+		 * Sets the weight of every feature. Positions set up before this keep the piece scores they had,
+		 * so this should only be done at startup, before any are.
+		 * @param newWeights The weight of each Feature
+		 */
+		static void setWeights(const int newWeights[FEATURES]);
+
+		/**
+		 * Sets the weights from a file with a feature name and weight on each line, like "kings 130"
+		 * (features left out keep their weight, and lines starting with # are ignored).
+		 * Like setWeights, this should only be done at startup.
+		 * @param path The file
+		 * @return Returns false (leaving the weights unchanged) if the file can't be read or isn't valid
+		 */
+		static bool loadWeights(const std::string& path);
+
+		/**
+		 * Writes the weights to a file that loadWeights can read.
+		 * @param path The file
+		 * @return Returns false if the file couldn't be written
+		 */
+		static bool saveWeights(const std::string& path);
+
+	private:
+		static int weights[FEATURES];
+		static int pieceValues[2][2][32]; // by color (white first), then man or king, then square
+};
+
+#endif
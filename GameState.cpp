@@ -0,0 +1,62 @@
+#include "GameState.h"
+
+#include "Board.h"
+#include "Position.h"
+#include "Typedefs.h"
+
+/**
+ * Responsible for starting to keep track of a game, with White to move.
+ * @param board The board the game is played on
+ */
+GameState::GameState(const Board& board) : whiteToMove(true), outcome(IN_PROGRESS)
+{
+    update(board);
+}
+
+/**
+ * Passes the turn to the other side, once a move has been made.
+ * @param board The board the move was made on
+ */
+void GameState::nextTurn(const Board& board)
+{
+    whiteToMove = !whiteToMove;
+    update(board);
+}
+
+/**
+ * @return Returns true if a side has any move at all (stopping at the first piece found with one)
+ * @param isWhite The side
+ */
+bool GameState::hasAnyLegalMove(bool isWhite) const
+{
+    // a side with no pieces has nothing to move, and most of the time a simple move turns up first
+    return pieceCounts[isWhite ? 0 : 1] > 0 &&
+           (position.getMovablePieces(isWhite) != 0 || position.getJumpingPieces(isWhite) != 0);
+}
+
+/**
+ * Catches up with the board after a move, and works out whether the game is over.
+ * @param board The board
+ */
+void GameState::update(const Board& board)
+{
+    position = board.getPosition();
+    pieceCounts[0] = Position::countSquares(position.getPieces(true));
+    pieceCounts[1] = Position::countSquares(position.getPieces(false));
+
+    // a player may have quit partway through the move
+    if (outcome == QUIT)
+        return;
+
+    // the game ends as soon as either side can't move: whoever can't has lost, or it's a stalemate if neither can
+    bool whiteCanMove = hasAnyLegalMove(true);
+    bool blackCanMove = hasAnyLegalMove(false);
+    if (!whiteCanMove && !blackCanMove)
+        outcome = STALEMATE;
+    else if (!whiteCanMove)
+        outcome = BLACK_WINS;
+    else if (!blackCanMove)
+        outcome = WHITE_WINS;
+    else
+        outcome = IN_PROGRESS;
+}
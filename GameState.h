@@ -0,0 +1,83 @@
+#ifndef GAME_STATE_H
+#define GAME_STATE_H
+
+#include "Typedefs.h"
+#include "Position.h"
+
+class Board;
+
+/**
+ * Keeps track of a game being played: whose turn it is, how many pieces each side has left,
+ * and whether the game is over (because either side can't move, or a player quit).
+ *
+ * Whether a side can move is worked out from the board's bitboards with a few shifts, stopping as soon
+ * as it finds a piece that can, so checking for the end of the game after a move costs next to nothing
+ * (instead of generating the moves of every piece on the board).
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+class GameState
+{
+	public:
+		// how the game stands
+		enum Outcome { IN_PROGRESS, WHITE_WINS, BLACK_WINS, STALEMATE, QUIT };
+
+		/**
+		 * Responsible for starting to keep track of a game, with White to move.
+		 * @param board The board the game is played on
+		 */
+		GameState(const Board& board);
+
+		/**
+		 * Passes the turn to the other side, once a move has been made.
+		 * @param board The board the move was made on
+		 */
+		void nextTurn(const Board& board);
+
+		/**
+		 * Ends the game early, such as when a player asks to exit.
+		 */
+		void quit() { outcome = QUIT; }
+
+		/**
+		 * @return Returns true if the game has ended, for any reason
+		 */
+		bool isOver() const { return outcome != IN_PROGRESS; }
+
+		/**
+		 * @return Returns how the game stands (see Outcome)
+		 */
+		int getOutcome() const { return outcome; }
+
+		/**
+		 * @return Returns true if it is White's turn
+		 */
+		bool isWhiteToMove() const { return whiteToMove; }
+
+		/**
+		 * @return Returns the number of pieces a side has left
+		 * @param isWhite The side
+		 */
+		int getPieceCount(bool isWhite) const { return pieceCounts[isWhite ? 0 : 1]; }
+
+		/**
+		 * @return Returns true if a side has any move at all (stopping at the first piece found with one)
+		 * @param isWhite The side
+		 */
+		bool hasAnyLegalMove(bool isWhite) const;
+
+	private:
+		Position position; // the pieces, as of the last move
+		bool whiteToMove;
+		int pieceCounts[2]; // white first
+		int outcome;
+
+		/**
+		 * Catches up with the board after a move, and works out whether the game is over.
+		 * @param board The board
+		 */
+		void update(const Board& board);
+};
+
+#endif
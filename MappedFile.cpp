@@ -0,0 +1,50 @@
+#include "MappedFile.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * Maps a file into memory (unmapping any file mapped before).
+ * @param path The path of the file
+ * @return Returns true if the file could be opened and mapped
+ */
+bool MappedFile::open(const std::string& path)
+{
+    close();
+
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0)
+        return false;
+
+    // an empty file can't be mapped, but there would be nothing to read from it anyway
+    struct stat status;
+    if (fstat(file, &status) != 0 || status.st_size == 0)
+    {
+        ::close(file);
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, file, 0);
+    ::close(file); // the mapping stays valid without the file being open
+
+    if (mapping == MAP_FAILED)
+        return false;
+
+    data = static_cast<const unsigned char*>(mapping);
+    size = status.st_size;
+    return true;
+}
+
+/**
+ * Unmaps the file, if one is mapped.
+ */
+void MappedFile::close()
+{
+    if (data != nullptr)
+        munmap(const_cast<unsigned char*>(data), size);
+
+    data = nullptr;
+    size = 0;
+}
@@ -0,0 +1,57 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+
+/**
+ * A file mapped read-only into memory, so it can be read like an array without loading it:
+ * the operating system only reads the parts that are actually touched, and every process
+ * mapping the same file shares the same memory.
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+class MappedFile
+{
+	public:
+		MappedFile() : data(nullptr), size(0) {};
+		~MappedFile() { close(); }
+
+		// a mapping can't be shared between two objects, since both would unmap it
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		/**
+		 * Maps a file into memory (unmapping any file mapped before).
+		 * @param path The path of the file
+		 * @return Returns true if the file could be opened and mapped
+		 */
+		bool open(const std::string& path);
+
+		/**
+		 * Unmaps the file, if one is mapped.
+		 */
+		void close();
+
+		/**
+		 * @return Returns true if a file is mapped
+		 */
+		bool isOpen() const { return data != nullptr; }
+
+		/**
+		 * @return Returns the contents of the file (null if none is mapped)
+		 */
+		const unsigned char* getData() const { return data; }
+
+		/**
+		 * @return Returns the size of the file in bytes
+		 */
+		size_t getSize() const { return size; }
+
+	private:
+		const unsigned char* data;
+		size_t size;
+};
+
+#endif
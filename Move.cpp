@@ -1,64 +1,88 @@
-#include "Move.h"
-
-#include "Piece.h"
-#include "Board.h"
-#include "Typedefs.h"
-
-/**
- * @return Returns a two-part array representing the coordinates of this move's starting position.
- */
-coords_t Move::getStartingPosition() const
-{
-    coords_t position;
-    position[0] = x1;
-    position[1] = y1;
-    return position;
-}
-
-/**
- * @return Returns a two-part array representing the coordinates of this move's ending position.
- */
-coords_t Move::getEndingPosition() const
-{
-    coords_t position;
-    position[0] = x2;
-    position[1] = y2;
-    return position;
-}
-    
-/**
- * Finds the pieces jumped in this move.
- * (Get's inbetween jumps using recursion)
- * @return Returns an array of pieces that were jumped.
- * @param board The board to look for the pieces on.
- */
-std::vector<Piece*> Move::getJumpedPieces(const Board& board) const
-{
-	// create expandable list of all pieces
-    std::vector<Piece*> pieces(0);
-    
-    // if this move wasn't a jump, it didn't jump a piece!
-    if (isJump)
-    {
-        // the piece this move is jumping should be between the start and end of this move
-        // (the average of those two positions)
-        int pieceX = (x1 + x2)/2;
-        int pieceY = (y1 + y2)/2;
-        
-        // add this most recent jump...
-        pieces.push_back(board.getValueAt(pieceX, pieceY));
-        
-        // ...but also go back to get the inbetween ones (if we're not the first move)
-        if (precedingMove != nullptr)
-        {
-            std::vector<Piece*> prevJumped = precedingMove->getJumpedPieces(board);
-            pieces.insert(pieces.end(), prevJumped.begin(), prevJumped.end()); 
-            
-            // something is wrong (a preceding move isn't a jump) if this returns null, so let the error be thrown
-        }
-    }
-    
-    // shorten and return
-    pieces.shrink_to_fit();
-    return pieces;
-}
+#include "Move.h"
+
+#include "Piece.h"
+#include "Board.h"
+#include "Position.h"
+#include "Typedefs.h"
+
+/**
+ * @return Returns a two-part array representing the coordinates of this move's starting position.
+ */
+coords_t Move::getStartingPosition() const
+{
+    return Position::getCoordsFromSquare(getFrom());
+}
+
+/**
+ * @return Returns a two-part array representing the coordinates of this move's ending position.
+ */
+coords_t Move::getEndingPosition() const
+{
+    return Position::getCoordsFromSquare(getTo());
+}
+
+/**
+ * Finds the pieces jumped in this move.
+ * @return Returns an array of pieces that were jumped.
+ * @param board The board to look for the pieces on.
+ */
+std::vector<Piece> Move::getJumpedPieces(const Board& board) const
+{
+	// create expandable list of all pieces
+    std::vector<Piece> pieces;
+
+    // if this move wasn't a jump, it didn't jump a piece!
+    bitboard_t remaining = jumped;
+    while (remaining)
+    {
+        coords_t coords = Position::getCoordsFromSquare(Position::popSquare(remaining));
+        pieces.push_back(board.getValueAt(coords[0], coords[1]));
+    }
+
+    return pieces;
+}
+
+/**
+ * @return Returns this move in checkers notation (see Position::getNotationNumber), such as
+ * "9-13" for a normal move or "9x18x27" for a jump, listing every square it lands on.
+ */
+std::string Move::getNotation() const
+{
+    std::string notation = std::to_string(Position::getNotationNumber(getFrom()));
+    if (!isJumpMove())
+        return notation + "-" + std::to_string(Position::getNotationNumber(getTo()));
+
+    // only the jumped pieces are stored, so retrace the landing squares from them
+    findJumpPath(getFrom(), jumped, notation);
+    return notation;
+}
+
+/**
+ * Recursively finds the squares a jump lands on, given only the pieces it jumped.
+ * @param square The square the piece has got to so far
+ * @param remaining The jumped pieces not yet accounted for
+ * @param notation The landing squares so far, which is added to if a path is found
+ * @return Returns true if a path from the square over every remaining piece to the end was found
+ */
+bool Move::findJumpPath(int square, bitboard_t remaining, std::string& notation) const
+{
+    if (!remaining)
+        return square == getTo();
+
+    for (int direction = Position::UP_LEFT; direction <= Position::DOWN_RIGHT; direction++)
+    {
+        bitboard_t over = Position::shift(1u << square, direction) & remaining;
+        bitboard_t landing = Position::shift(over, direction);
+        if (!landing)
+            continue;
+
+        // a king can jump in a loop, so a path that can't finish has to be backed out of
+        size_t length = notation.size();
+        int landingSquare = Position::popSquare(landing);
+        notation += "x" + std::to_string(Position::getNotationNumber(landingSquare));
+        if (findJumpPath(landingSquare, remaining & ~over, notation))
+            return true;
+        notation.resize(length);
+    }
+    return false;
+}
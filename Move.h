@@ -1,56 +1,111 @@
-#ifndef MOVE_H
-#define MOVE_H
-
-#include <array>
-#include <vector>
-#include "Typedefs.h"
-
-class Piece;
-class Board;
-
-/**
- * Represents a single move of a piece.
- * 
- * @author Mckenna Cisler
- * @version 5.18.2015
- */
-class Move
-{
-	private:
-	    const int x1, y1, x2, y2;
-    	const move_ptr_t precedingMove;
-    	const bool isJump;
-    
-    public:    
-		/**
-		 * Constructor for objects of class Move - initializes starting and final position.
-		 * @param x1 Starting x position.
-		 * @param y1 Starting y position.
-		 * @param x2 Ending x position.
-		 * @param y2 Ending y position.
-		 * @param precedingMove The move preceding this one (can be null if move is first)
-		 */
-		Move(int x1, int y1, int x2, int y2, const move_ptr_t precedingMove, bool isJump) :
-			x1(x1), y1(y1), x2(x2), y2(y2), precedingMove(precedingMove), isJump(isJump)
-			{};
-
-		/**
-		 * @return Returns a two-part array representing the coordinates of this move's starting position.
-		 */
-		coords_t getStartingPosition() const;
-		
-		/**
-		 * @return Returns a two-part array representing the coordinates of this move's ending position.
-		 */
-		coords_t getEndingPosition() const;
-		
-		/**
-		 * Finds the pieces jumped in this move.
-		 * (Get's inbetween jumps using recursion)
-		 * @return Returns an array of pieces that were jumped.
-		 * @param board The board to look for the pieces on.
-		 */
-		std::vector<Piece*> getJumpedPieces(const Board& board) const;
-};
-
-#endif
+#ifndef MOVE_H
+#define MOVE_H
+
+#include <array>
+#include <vector>
+#include <string>
+#include "Typedefs.h"
+
+class Piece;
+class Board;
+
+/**
+ * Represents a single move of a piece: the square it starts on, the square it ends on,
+ * every piece it jumps along the way, and whether it gets crowned.
+ * A move is just two words, so it is passed around and stored by value (see MoveList.h).
+ *
+ * @author Mckenna Cisler
+ * @version 5.18.2015
+ */
+class Move
+{
+	private:
+		bitboard_t jumped; // the squares of every piece jumped, from the origin on
+		uint32_t squares;  // the starting square, the ending square and the crowning flag, packed
+
+    public:
+		/**
+		 * Constructor for a move that is left unset (so lists of moves cost nothing to create).
+		 * Value-initializing one instead, as in Move(), gives the empty ("null") move.
+		 */
+		Move() = default;
+
+		/**
+		 * Constructor for objects of class Move - initializes starting and final position.
+		 * @param from The square the piece starts on (see Position.h for square numbers)
+		 * @param to The square the piece ends on
+		 * @param jumped The squares of the pieces jumped getting there (zero if it isn't a jump)
+		 * @param crowns True if the piece is a man that is crowned by this move
+		 */
+		Move(int from, int to, bitboard_t jumped, bool crowns) :
+			jumped(jumped), squares(from | to << 5 | (crowns ? 1 << 10 : 0))
+			{};
+
+		/**
+		 * @return Returns the square the piece starts on
+		 */
+		int getFrom() const { return squares & 31; }
+
+		/**
+		 * @return Returns the square the piece ends on
+		 */
+		int getTo() const { return (squares >> 5) & 31; }
+
+		/**
+		 * @return Returns the squares of every piece jumped in this move
+		 */
+		bitboard_t getJumped() const { return jumped; }
+
+		/**
+		 * @return Returns true if this move is a jump
+		 */
+		bool isJumpMove() const { return jumped != 0; }
+
+		/**
+		 * @return Returns true if the moving piece is crowned at the end of this move
+		 */
+		bool isCrowning() const { return (squares >> 10) & 1; }
+
+		/**
+		 * @return Returns true if this is the empty move (which starts and ends on the same square)
+		 */
+		bool isNull() const { return getFrom() == getTo(); }
+
+		bool operator==(const Move& other) const { return jumped == other.jumped && squares == other.squares; }
+		bool operator!=(const Move& other) const { return !(*this == other); }
+
+		/**
+		 * @return Returns a two-part array representing the coordinates of this move's starting position.
+		 */
+		coords_t getStartingPosition() const;
+
+		/**
+		 * @return Returns a two-part array representing the coordinates of this move's ending position.
+		 */
+		coords_t getEndingPosition() const;
+
+		/**
+		 * Finds the pieces jumped in this move.
+		 * @return Returns an array of pieces that were jumped.
+		 * @param board The board to look for the pieces on.
+		 */
+		std::vector<Piece> getJumpedPieces(const Board& board) const;
+
+		/**
+		 * @return Returns this move in checkers notation (see Position::getNotationNumber), such as
+		 * "9-13" for a normal move or "9x18x27" for a jump, listing every square it lands on.
+		 */
+		std::string getNotation() const;
+
+	private:
+		/**
+		 * Recursively finds the squares a jump lands on, given only the pieces it jumped.
+		 * @param square The square the piece has got to so far
+		 * @param remaining The jumped pieces not yet accounted for
+		 * @param notation The landing squares so far, which is added to if a path is found
+		 * @return Returns true if a path from the square over every remaining piece to the end was found
+		 */
+		bool findJumpPath(int square, bitboard_t remaining, std::string& notation) const;
+};
+
+#endif
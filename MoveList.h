@@ -0,0 +1,66 @@
+#ifndef MOVE_LIST_H
+#define MOVE_LIST_H
+
+#include "Move.h"
+
+#include <type_traits>
+#include <cassert>
+
+/**
+ * A list of moves with a fixed capacity, so it can live on the stack and be filled
+ * by the move generator without ever allocating memory.
+ * It has the same basic interface as a vector (push_back, size, [] and so on).
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+class MoveList
+{
+	public:
+		// more moves than any position can have, counting every step of every jump as its own move
+		// (12 pieces with at most 4 steps each make 48 plain moves, and a hill-climbing search over
+		// king-heavy positions never found more than 96 moves once jumps were counted this way)
+		const static int CAPACITY = 128;
+
+		MoveList() : count(0) {};
+
+		/**
+		 * Adds a move to the end of the list, which must not already be full.
+		 * @param move The move to add
+		 */
+		void push_back(const Move& move) { assert(count < CAPACITY); moves[count++] = move; }
+
+		/**
+		 * Removes every move from the list.
+		 */
+		void clear() { count = 0; }
+
+		/**
+		 * @return Returns the number of moves in the list
+		 */
+		unsigned int size() const { return count; }
+
+		/**
+		 * @return Returns true if the list has no moves
+		 */
+		bool empty() const { return count == 0; }
+
+		Move& operator[](unsigned int i) { return moves[i]; }
+		const Move& operator[](unsigned int i) const { return moves[i]; }
+
+		Move* begin() { return moves; }
+		Move* end() { return moves + count; }
+		const Move* begin() const { return moves; }
+		const Move* end() const { return moves + count; }
+
+	private:
+		static_assert(std::is_trivial<Move>::value, "creating a list shouldn't have to set up every move in it");
+
+		Move moves[CAPACITY];
+		unsigned int count;
+};
+
+// most of the game just talks about "the moves" (see Typedefs.h for the other shared types)
+typedef MoveList moves_t;
+
+#endif
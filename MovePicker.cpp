@@ -0,0 +1,130 @@
+#include "MovePicker.h"
+
+#include "Position.h"
+#include "Move.h"
+#include "MoveList.h"
+#include "Search.h"
+#include "Typedefs.h"
+
+#include <utility>
+#include <climits>
+
+/**
+ * Responsible for generating the moves of a position, to be picked from.
+ * @param position The position
+ * @param moves The list to generate the moves into (which is reordered as they are picked)
+ * @param tableMove The move the transposition table suggests (as encoded by Search::encodeMove), or 0
+ * @param killers The killer moves of this ply (null moves for empty slots)
+ * @param history The history scores
+ */
+MovePicker::MovePicker(const Position& position, moves_t& moves, uint16_t tableMove, const Move killers[KILLERS],
+                       const history_t& history) :
+    moves(moves), picked(0), stage(TABLE_MOVE), stageIndex(0), lastStage(QUIET_MOVES), tableMove(tableMove),
+    killers(killers), history(history[position.isWhiteToMove() ? 0 : 1])
+{
+    position.getMoves(moves);
+}
+
+/**
+ * Responsible for generating only the jumps of a position, to be picked from (longest first).
+ * @param position The position
+ * @param moves The list to generate the jumps into (which is reordered as they are picked)
+ */
+MovePicker::MovePicker(const Position& position, moves_t& moves) :
+    moves(moves), picked(0), stage(CAPTURES), stageIndex(0), lastStage(CAPTURES), tableMove(0),
+    killers(nullptr), history(nullptr)
+{
+    position.getJumps(moves);
+}
+
+/**
+ * Picks the next move to try.
+ * @param move Set to the move
+ * @return Returns false if every move has already been picked
+ */
+bool MovePicker::next(Move& move)
+{
+    for (; stage <= lastStage; stage++, stageIndex = 0)
+    {
+        if (stage == TABLE_MOVE)
+        {
+            // (only ever one move, the first time through)
+            for (unsigned int i = picked; tableMove != 0 && stageIndex == 0 && i < moves.size(); i++)
+            {
+                if (Search::encodeMove(moves[i]) == tableMove)
+                {
+                    stageIndex++;
+                    move = take(i);
+                    return true;
+                }
+            }
+        }
+        else if (stage == CAPTURES)
+        {
+            // the jump that takes the most pieces
+            int best = -1, bestCount = 0;
+            for (unsigned int i = picked; i < moves.size(); i++)
+            {
+                int count = Position::countSquares(moves[i].getJumped());
+                if (count > bestCount)
+                {
+                    best = i;
+                    bestCount = count;
+                }
+            }
+            if (best >= 0)
+            {
+                move = take(best);
+                return true;
+            }
+        }
+        else if (stage == KILLER_MOVES)
+        {
+            // a killer is only tried if it is one of this position's moves (and hasn't been tried already)
+            while (stageIndex < KILLERS)
+            {
+                const Move& killer = killers[stageIndex++];
+                for (unsigned int i = picked; !killer.isNull() && i < moves.size(); i++)
+                {
+                    if (moves[i] == killer)
+                    {
+                        move = take(i);
+                        return true;
+                    }
+                }
+            }
+        }
+        else if (stage == QUIET_MOVES)
+        {
+            // only quiet moves are left by now
+            int best = -1, bestScore = INT_MIN;
+            for (unsigned int i = picked; i < moves.size(); i++)
+            {
+                int score = history[moves[i].getFrom()][moves[i].getTo()];
+                if (score > bestScore)
+                {
+                    best = i;
+                    bestScore = score;
+                }
+            }
+            if (best >= 0)
+            {
+                move = take(best);
+                return true;
+            }
+        }
+    }
+    stage = DONE;
+    return false;
+}
+
+/**
+ * Hands out the move at the given index, by swapping it to the end of those already picked.
+ * @param index The index of a move not yet picked
+ * @return Returns the move
+ */
+Move MovePicker::take(unsigned int index)
+{
+    std::swap(moves[picked], moves[index]);
+    return moves[picked++];
+}
@@ -0,0 +1,81 @@
+#ifndef MOVE_PICKER_H
+#define MOVE_PICKER_H
+
+#include "Typedefs.h"
+#include "Position.h"
+#include "MoveList.h"
+
+/**
+ * Hands out the moves of a position one at a time, best guess first, for the search to try:
+ * the move the transposition table remembers as best, then jumps (the more pieces taken, the sooner),
+ * then the killer moves (quiet moves that caused a cutoff at the same ply elsewhere in the tree),
+ * then the remaining quiet moves by their history score (how often and how deep they caused cutoffs).
+ *
+ * The moves are never sorted: each one is picked out of those left only when it is asked for,
+ * so a cutoff after the first few moves wastes no work on ordering the rest.
+ * A picker can also hand out only the jumps (for the quiescence search), without generating anything else.
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+class MovePicker
+{
+	public:
+		// the number of killer moves remembered for each ply
+		const static int KILLERS = 2;
+
+		// the history score of every quiet move, by the color moving (white first), then its starting and ending squares
+		typedef int history_t[2][Position::SQUARES][Position::SQUARES];
+
+		// the order moves are handed out in
+		enum Stage { TABLE_MOVE, CAPTURES, KILLER_MOVES, QUIET_MOVES, DONE };
+
+		/**
+		 * Responsible for generating the moves of a position, to be picked from.
+		 * @param position The position
+		 * @param moves The list to generate the moves into (which is reordered as they are picked)
+		 * @param tableMove The move the transposition table suggests (as encoded by Search::encodeMove), or 0
+		 * @param killers The killer moves of this ply (null moves for empty slots)
+		 * @param history The history scores
+		 */
+		MovePicker(const Position& position, moves_t& moves, uint16_t tableMove, const Move killers[KILLERS],
+		           const history_t& history);
+
+		/**
+		 * Responsible for generating only the jumps of a position, to be picked from (longest first).
+		 * @param position The position
+		 * @param moves The list to generate the jumps into (which is reordered as they are picked)
+		 */
+		MovePicker(const Position& position, moves_t& moves);
+
+		/**
+		 * Picks the next move to try.
+		 * @param move Set to the move
+		 * @return Returns false if every move has already been picked
+		 */
+		bool next(Move& move);
+
+		/**
+		 * @return Returns the Stage the last move was picked in
+		 */
+		int getStage() const { return stage; }
+
+	private:
+		moves_t& moves;
+		unsigned int picked; // the moves before this have been handed out, and the rest haven't
+		int stage;
+		int stageIndex;      // how far through the stage's own list (such as the killers) it has got
+		int lastStage;       // the last Stage to pick from
+		uint16_t tableMove;
+		const Move* killers;
+		const int (*history)[Position::SQUARES]; // the history of the side to move
+
+		/**
+		 * Hands out the move at the given index, by swapping it to the end of those already picked.
+		 * @param index The index of a move not yet picked
+		 * @return Returns the move
+		 */
+		Move take(unsigned int index);
+};
+
+#endif
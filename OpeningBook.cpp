@@ -0,0 +1,162 @@
+#include "OpeningBook.h"
+
+#include "Position.h"
+#include "Search.h"
+#include "MoveList.h"
+#include "Typedefs.h"
+
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+
+// what goes at the start of every book, to recognise it
+static const char MAGIC[4] = { 'C', 'K', 'O', 'B' };
+static const uint32_t VERSION = 1;
+static const size_t HEADER_SIZE = 16;
+
+static_assert(sizeof(OpeningBook::Entry) == 16, "book entries must have the same layout in every build");
+
+/**
+ * Maps a book file into memory (closing any book opened before).
+ * @param path The path of the file
+ * @return Returns true if the file is a valid book
+ */
+bool OpeningBook::open(const std::string& path)
+{
+    entries = nullptr;
+    count = 0;
+    if (!file.open(path) || file.getSize() < HEADER_SIZE)
+    {
+        file.close();
+        return false;
+    }
+
+    const unsigned char* bytes = file.getData();
+    uint32_t version;
+    uint64_t size;
+    std::memcpy(&version, bytes + 4, sizeof(version));
+    std::memcpy(&size, bytes + 8, sizeof(size));
+
+    if (std::memcmp(bytes, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION ||
+        file.getSize() != HEADER_SIZE + size * sizeof(Entry))
+    {
+        file.close();
+        return false;
+    }
+
+    entries = reinterpret_cast<const Entry*>(bytes + HEADER_SIZE);
+    count = size;
+    return true;
+}
+
+/**
+ * Finds the moves the book has for a position.
+ * @param position The position to look up
+ * @param moves Filled with the moves (which are all legal in the position)
+ * @param weights Filled with the weight of each move
+ * @return Returns true if the book has any moves for the position
+ */
+bool OpeningBook::getMoves(const Position& position, std::vector<Move>& moves, std::vector<int>& weights) const
+{
+    moves.clear();
+    weights.clear();
+    if (count == 0)
+        return false;
+
+    // every move from a position is stored next to each other, so find the first and read on from there
+    uint64_t key = position.getKey();
+    const Entry* entry = std::lower_bound(entries, entries + count, key,
+        [](const Entry& entry, uint64_t key) { return entry.key < key; });
+    if (entry == entries + count || entry->key != key)
+        return false;
+
+    // the moves are stored encoded, so match them up with the moves that are actually legal here
+    // (which also guards against another position that happens to share the key)
+    MoveList legalMoves;
+    position.getMoves(legalMoves);
+
+    for (; entry != entries + count && entry->key == key; entry++)
+    {
+        for (unsigned int i = 0; i < legalMoves.size(); i++)
+        {
+            if (Search::encodeMove(legalMoves[i]) == entry->move && entry->weight > 0)
+            {
+                moves.push_back(legalMoves[i]);
+                weights.push_back(entry->weight);
+                break;
+            }
+        }
+    }
+    return !moves.empty();
+}
+
+/**
+ * Chooses a move for a position from the book, more often the heavier its weight.
+ * @param position The position to look up
+ * @param random A random number, which decides the move
+ * @param move Set to the move chosen
+ * @return Returns true if the book has any moves for the position
+ */
+bool OpeningBook::probe(const Position& position, uint64_t random, Move& move) const
+{
+    std::vector<Move> moves;
+    std::vector<int> weights;
+    if (!getMoves(position, moves, weights))
+        return false;
+
+    uint64_t total = 0;
+    for (unsigned int i = 0; i < weights.size(); i++)
+        total += weights[i];
+
+    uint64_t choice = random % total;
+    for (unsigned int i = 0; i < moves.size(); i++)
+    {
+        if (choice < (uint64_t)weights[i])
+        {
+            move = moves[i];
+            return true;
+        }
+        choice -= weights[i];
+    }
+    return false;
+}
+
+/**
+ * Writes a book to a file, sorting the entries (and adding together the weights of any duplicates).
+ * @param path The path of the file to write
+ * @param entries The entries to write
+ * @return Returns the number of entries written, or 0 if the file couldn't be written
+ */
+size_t OpeningBook::write(const std::string& path, std::vector<Entry> entries)
+{
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b)
+    { return a.key != b.key ? a.key < b.key : a.move < b.move; });
+
+    size_t kept = 0;
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        if (kept > 0 && entries[kept - 1].key == entries[i].key && entries[kept - 1].move == entries[i].move)
+        {
+            entries[kept - 1].weight = (uint16_t)std::min(entries[kept - 1].weight + entries[i].weight, 0xFFFF);
+            continue;
+        }
+        entries[kept] = entries[i];
+        entries[kept].unused = 0;
+        kept++;
+    }
+    entries.resize(kept);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return 0;
+
+    uint64_t size = entries.size();
+    file.write(MAGIC, sizeof(MAGIC));
+    file.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+    file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+
+    if (!file)
+        return 0;
+    return entries.size();
+}
@@ -0,0 +1,87 @@
+#ifndef OPENING_BOOK_H
+#define OPENING_BOOK_H
+
+#include "MappedFile.h"
+#include "Move.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+class Position;
+
+/**
+ * A book of opening moves, built ahead of time by the bookgen tool, so the AI can play the
+ * first moves of a game without searching.
+ *
+ * The file is a sorted array of entries, each holding a position's Zobrist key, one move that can
+ * be played from it and how often it should be chosen. It is memory-mapped and binary-searched
+ * where it lies, so opening it costs nothing, and every process using it shares the same memory.
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+class OpeningBook
+{
+	public:
+		// one move from one position, as stored in the file
+		struct Entry
+		{
+			uint64_t key;    // the Zobrist key of the position
+			uint16_t move;   // the move (see Search::encodeMove)
+			uint16_t weight; // how often to choose the move, relative to the others from the position
+			uint32_t unused; // (keeps the entries aligned)
+		};
+
+		OpeningBook() : entries(nullptr), count(0) {};
+
+		/**
+		 * Maps a book file into memory (closing any book opened before).
+		 * @param path The path of the file
+		 * @return Returns true if the file is a valid book
+		 */
+		bool open(const std::string& path);
+
+		/**
+		 * @return Returns true if a book is open
+		 */
+		bool isOpen() const { return file.isOpen(); }
+
+		/**
+		 * @return Returns the number of entries in the book
+		 */
+		size_t getSize() const { return count; }
+
+		/**
+		 * Finds the moves the book has for a position.
+		 * @param position The position to look up
+		 * @param moves Filled with the moves (which are all legal in the position)
+		 * @param weights Filled with the weight of each move
+		 * @return Returns true if the book has any moves for the position
+		 */
+		bool getMoves(const Position& position, std::vector<Move>& moves, std::vector<int>& weights) const;
+
+		/**
+		 * Chooses a move for a position from the book, more often the heavier its weight.
+		 * @param position The position to look up
+		 * @param random A random number, which decides the move
+		 * @param move Set to the move chosen
+		 * @return Returns true if the book has any moves for the position
+		 */
+		bool probe(const Position& position, uint64_t random, Move& move) const;
+
+		/**
+		 * Writes a book to a file, sorting the entries (and adding together the weights of any duplicates).
+		 * @param path The path of the file to write
+		 * @param entries The entries to write
+		 * @return Returns the number of entries written, or 0 if the file couldn't be written
+		 */
+		static size_t write(const std::string& path, std::vector<Entry> entries);
+
+	private:
+		MappedFile file;
+		const Entry* entries;
+		size_t count;
+};
+
+#endif
@@ -0,0 +1,246 @@
+#include "PdnReader.h"
+
+#include "Board.h"
+#include "Position.h"
+#include "Move.h"
+#include "Typedefs.h"
+
+#include <cstring>
+
+// the longest FEN tag that is read (anything longer can't be a real position)
+static const size_t MAX_FEN_TAG = 256;
+
+/**
+ * @return Returns true if the token's text is exactly the given string
+ */
+static bool isText(const char* text, size_t length, const char* string)
+{
+    return length == std::strlen(string) && std::memcmp(text, string, length) == 0;
+}
+
+/**
+ * @return Returns true if the character ends a word (whitespace, or the start or end of something else)
+ */
+static bool isDelimiter(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '{' || c == '}' || c == '(' || c == ')' ||
+           c == '[' || c == ']' || c == ';' || c == '"';
+}
+
+/**
+ * Replays every game in the archive, from the start.
+ * @param onMove Called for every move (see MoveCallback)
+ * @return Returns the number of games read
+ */
+long long PdnReader::read(const MoveCallback& onMove)
+{
+    games = moves = errors = 0;
+    if (!file.isOpen())
+        return 0;
+
+    const char* at = reinterpret_cast<const char*>(file.getData());
+    const char* end = at + file.getSize();
+    Token token = readToken(at, end);
+
+    while (token.type != END)
+    {
+        // the tags come first, of which only the result and the starting position matter here
+        int result = UNKNOWN;
+        const char* fen = nullptr;
+        size_t fenLength = 0;
+        for (; token.type == TAG; token = readToken(at, end))
+        {
+            if (isText(token.text, token.length, "Result"))
+            {
+                Token value = { RESULT, token.value, token.value, token.valueLength, nullptr, 0 };
+                result = getResult(value);
+            }
+            else if (isText(token.text, token.length, "FEN"))
+            {
+                fen = token.value;
+                fenLength = token.valueLength;
+            }
+        }
+
+        // find where the moves end, and the result written there (which wins over the tag)
+        const char* movesStart = token.start;
+        const char* movesEnd = movesStart;
+        while (token.type == MOVE)
+        {
+            movesEnd = at;
+            token = readToken(at, end);
+        }
+        if (token.type == RESULT)
+        {
+            result = getResult(token);
+            movesEnd = token.start;
+            token = readToken(at, end);
+        }
+        games++;
+
+        // set up the starting position, with PDN's colors swapped for ours
+        Board board;
+        if (fen != nullptr)
+        {
+            char swapped[MAX_FEN_TAG];
+            Position start;
+            if (fenLength > MAX_FEN_TAG)
+            {
+                errors++;
+                continue;
+            }
+            for (size_t i = 0; i < fenLength; i++)
+                swapped[i] = fen[i] == 'W' ? 'B' : fen[i] == 'B' ? 'W' : fen[i];
+            if (!start.setFromFen(swapped, fenLength))
+            {
+                errors++;
+                continue;
+            }
+            board = Board(start);
+        }
+
+        // then replay the moves
+        const char* replay = movesStart;
+        for (int ply = 0; replay < movesEnd; ply++)
+        {
+            Token move = readToken(replay, movesEnd);
+            if (move.type != MOVE)
+                break;
+
+            Move found;
+            if (!board.getPosition().findMove(move.text, move.length, found))
+            {
+                errors++;
+                break;
+            }
+
+            onMove(board.getPosition(), found, result, ply);
+            moves++;
+
+            board.applyMoveToBoard(found);
+        }
+    }
+    return games;
+}
+
+/**
+ * Reads the next token, skipping anything that isn't one (whitespace, comments, variations,
+ * move numbers and annotations).
+ * @param at Where to read from, which is moved past the token
+ * @param end The end of the archive
+ * @return Returns the token
+ */
+PdnReader::Token PdnReader::readToken(const char*& at, const char* end)
+{
+    Token token = { END, end, end, 0, nullptr, 0 };
+    int variationDepth = 0;
+
+    while (at < end)
+    {
+        char c = *at;
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+            at++;
+        else if (c == '{')
+        {
+            // a comment, up to the closing brace
+            const char* close = static_cast<const char*>(std::memchr(at, '}', end - at));
+            at = close != nullptr ? close + 1 : end;
+        }
+        else if (c == ';')
+        {
+            // a comment to the end of the line
+            const char* newline = static_cast<const char*>(std::memchr(at, '\n', end - at));
+            at = newline != nullptr ? newline + 1 : end;
+        }
+        else if (c == '(' || c == ')')
+        {
+            // a variation (which can have others inside it), all of which is skipped
+            variationDepth += c == '(' ? 1 : variationDepth > 0 ? -1 : 0;
+            at++;
+        }
+        else if (c == '[' && variationDepth == 0)
+        {
+            // a tag, like [Result "1-0"]
+            token.type = TAG;
+            token.start = at++;
+            while (at < end && (*at == ' ' || *at == '\t'))
+                at++;
+            token.text = at;
+            while (at < end && !isDelimiter(*at))
+                at++;
+            token.length = at - token.text;
+
+            const char* quote = static_cast<const char*>(std::memchr(at, '"', end - at));
+            const char* close = static_cast<const char*>(std::memchr(at, ']', end - at));
+            if (quote != nullptr && (close == nullptr || quote < close))
+            {
+                token.value = quote + 1;
+                const char* endQuote = static_cast<const char*>(std::memchr(token.value, '"', end - token.value));
+                token.valueLength = (endQuote != nullptr ? endQuote : end) - token.value;
+                close = endQuote != nullptr ? static_cast<const char*>(std::memchr(endQuote, ']', end - endQuote)) : nullptr;
+            }
+            else
+                token.value = at;
+            at = close != nullptr ? close + 1 : end;
+            return token;
+        }
+        else
+        {
+            // a word: a move, a result, a move number (or move number and move run together) or an annotation
+            const char* start = at;
+            while (at < end && !isDelimiter(*at))
+                at++;
+
+            // (skipping any stray delimiter, or anything in a variation)
+            if (at == start)
+                at++;
+            if (at == start + 1 && isDelimiter(*start))
+                continue;
+            if (variationDepth > 0)
+                continue;
+
+            const char* text = start;
+            size_t length = at - start;
+            Token word = { RESULT, start, text, length, nullptr, 0 };
+            if (isText(text, length, "1-0") || isText(text, length, "0-1") || isText(text, length, "1/2-1/2") ||
+                isText(text, length, "*") || isText(text, length, "2-0") || isText(text, length, "0-2") ||
+                isText(text, length, "1-1") || isText(text, length, "0-0"))
+                return word;
+
+            // skip a move number ("12." or "12...")
+            const char* afterNumber = at;
+            while (afterNumber > text && afterNumber[-1] != '.')
+                afterNumber--;
+            length -= afterNumber - text;
+            text = afterNumber;
+
+            // and any annotation after the move (like "9-13!")
+            while (length > 0 && !(text[length - 1] >= '0' && text[length - 1] <= '9'))
+                length--;
+
+            if (length > 0 && text[0] >= '0' && text[0] <= '9')
+            {
+                word.type = MOVE;
+                word.text = text;
+                word.length = length;
+                return word;
+            }
+        }
+    }
+    return token;
+}
+
+/**
+ * @return Returns the Result a result token stands for
+ */
+int PdnReader::getResult(const Token& token)
+{
+    // PDN's White is our Black (see the top of PdnReader.h)
+    if (isText(token.text, token.length, "1-0") || isText(token.text, token.length, "2-0"))
+        return BLACK_WIN;
+    else if (isText(token.text, token.length, "0-1") || isText(token.text, token.length, "0-2"))
+        return WHITE_WIN;
+    else if (isText(token.text, token.length, "1/2-1/2") || isText(token.text, token.length, "1-1"))
+        return DRAW;
+    return UNKNOWN;
+}
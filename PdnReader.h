@@ -0,0 +1,109 @@
+#ifndef PDN_READER_H
+#define PDN_READER_H
+
+#include "MappedFile.h"
+
+#include <string>
+#include <functional>
+
+class Position;
+class Move;
+
+/**
+ * Reads archives of games in PDN (Portable Draughts Notation), replaying every move of every game
+ * on a Board and handing each one, with the position it was played in and how the game ended,
+ * to a callback.
+ *
+ * The archive is memory-mapped and split into tokens where it lies, so reading it allocates nothing
+ * for each game beyond the Board the game is replayed on, and runs about as fast as the disk.
+ *
+ * PDN follows the usual checkers convention that Black moves first, from squares 1-12, which is our
+ * White: so PDN's Black is White here (and the other way around), in results and in [FEN "..."] tags.
+ * Comments, variations, move numbers and annotations are skipped. A game with an illegal move is
+ * abandoned at that move (and counted as an error).
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+class PdnReader
+{
+	public:
+		// how a game ended (in our colors)
+		enum Result { UNKNOWN = 0, WHITE_WIN = 1, BLACK_WIN = 2, DRAW = 3 };
+
+		/**
+		 * Called for every move of every game.
+		 * @param position The position the move was played in
+		 * @param move The move
+		 * @param result The Result of the game
+		 * @param ply The number of moves played in the game before this one
+		 */
+		typedef std::function<void(const Position& position, const Move& move, int result, int ply)> MoveCallback;
+
+		PdnReader() : games(0), moves(0), errors(0) {};
+
+		/**
+		 * Maps an archive into memory (closing any opened before).
+		 * @param path The path of the archive
+		 * @return Returns true if the archive could be opened
+		 */
+		bool open(const std::string& path) { games = moves = errors = 0; return file.open(path); }
+
+		/**
+		 * Replays every game in the archive, from the start.
+		 * @param onMove Called for every move (see MoveCallback)
+		 * @return Returns the number of games read
+		 */
+		long long read(const MoveCallback& onMove);
+
+		/**
+		 * @return Returns the number of games read by the last read
+		 */
+		long long getGames() const { return games; }
+
+		/**
+		 * @return Returns the number of moves replayed by the last read
+		 */
+		long long getMoves() const { return moves; }
+
+		/**
+		 * @return Returns the number of games the last read had to abandon (at an illegal move or position)
+		 */
+		long long getErrors() const { return errors; }
+
+	private:
+		// the kinds of token an archive is made of
+		enum TokenType { END, TAG, MOVE, RESULT };
+
+		// a piece of the archive, pointing into it rather than copied out of it
+		struct Token
+		{
+			TokenType type;
+			const char* start;  // where the token starts (to go back to it)
+			const char* text;   // the move, result or tag name
+			size_t length;
+			const char* value;  // the value of a tag
+			size_t valueLength;
+		};
+
+		MappedFile file;
+		long long games;
+		long long moves;
+		long long errors;
+
+		/**
+		 * Reads the next token, skipping anything that isn't one (whitespace, comments, variations,
+		 * move numbers and annotations).
+		 * @param at Where to read from, which is moved past the token
+		 * @param end The end of the archive
+		 * @return Returns the token
+		 */
+		static Token readToken(const char*& at, const char* end);
+
+		/**
+		 * @return Returns the Result a result token stands for
+		 */
+		static int getResult(const Token& token);
+};
+
+#endif
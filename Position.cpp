@@ -0,0 +1,603 @@
+#include "Position.h"
+
+#include "Board.h"
+#include "Evaluator.h"
+#include "Move.h"
+#include "Zobrist.h"
+#include "Typedefs.h"
+
+#include <cstring>
+#include <cstdlib>
+
+// the rows a piece is crowned on (white moves down the board, black moves up it)
+static const bitboard_t WHITE_KING_ROW = 0xF0000000;
+static const bitboard_t BLACK_KING_ROW = 0x0000000F;
+
+const size_t Position::MAX_FEN_LENGTH;
+const char* const Position::START_FEN = "W:W1,2,3,4,5,6,7,8,9,10,11,12:B21,22,23,24,25,26,27,28,29,30,31,32";
+
+/**
+ * Reads a square's notation number (1-32) from FEN, moving past it.
+ * @param at The next character to read, which is moved past the number
+ * @param end The end of the FEN
+ * @param number Set to the number read
+ * @return Returns false if there isn't a number on the board here
+ */
+static bool readNotationNumber(const char*& at, const char* end, int& number)
+{
+    number = 0;
+    const char* start = at;
+    while (at < end && *at >= '0' && *at <= '9' && at - start < 2)
+        number = number * 10 + (*at++ - '0');
+    return at > start && number >= 1 && number <= Position::SQUARES;
+}
+
+/**
+ * Writes a square's notation number (1-32) into FEN.
+ * @param number The number
+ * @param at Where to write it, which is moved past it
+ */
+static void writeNotationNumber(int number, char*& at)
+{
+    if (number >= 10)
+        *at++ = (char)('0' + number / 10);
+    *at++ = (char)('0' + number % 10);
+}
+
+/**
+ * Converts a square number to x and y coordinates.
+ * @param square The square number, 0-31.
+ * @return A two part int array where [0] is the x coordinate and [1] is the y.
+ */
+coords_t Position::getCoordsFromSquare(int square)
+{
+    coords_t coords;
+    coords[1] = square / (Board::SIZE / 2);
+    coords[0] = (square % (Board::SIZE / 2)) * 2 + coords[1] % 2; // odd rows are shifted over one
+    return coords;
+}
+
+/**
+ * Sets whose turn it is to move.
+ * @param isWhite True if it should be white's turn
+ */
+void Position::setWhiteToMove(bool isWhite)
+{
+    if (isWhite != whiteToMove)
+        key ^= Zobrist::getSideKey();
+    whiteToMove = isWhite;
+}
+
+/**
+ * Places a piece on the given square (replacing anything already there).
+ * @param square The square number
+ * @param isWhite The color of the piece
+ * @param isKing Whether the piece is a king
+ */
+void Position::setPiece(int square, bool isWhite, bool isKing)
+{
+    clearSquare(square);
+
+    bitboard_t bit = 1u << square;
+    if (isWhite)
+        whitePieces |= bit;
+    else
+        blackPieces |= bit;
+
+    if (isKing)
+        kings |= bit;
+
+    key ^= Zobrist::getPieceKey(square, isWhite, isKing);
+    pieceScore += Evaluator::getPieceValue(square, isWhite, isKing);
+}
+
+/**
+ * Removes any piece from the given square.
+ * @param square The square number
+ */
+void Position::clearSquare(int square)
+{
+    bitboard_t bit = 1u << square;
+    if ((whitePieces | blackPieces) & bit)
+    {
+        key ^= Zobrist::getPieceKey(square, (whitePieces & bit) != 0, (kings & bit) != 0);
+        pieceScore -= Evaluator::getPieceValue(square, (whitePieces & bit) != 0, (kings & bit) != 0);
+    }
+
+    whitePieces &= ~bit;
+    blackPieces &= ~bit;
+    kings &= ~bit;
+}
+
+/**
+ * Applies the given Move (including all pieces it jumps) to this position,
+ * crowning the moving piece if it reaches the far side of the board, and passes the turn.
+ * @param move The Move to apply, which must start at a piece in this position.
+ */
+void Position::applyMove(const Move& move)
+{
+    UndoRecord undo;
+    makeMove(move, undo);
+}
+
+/**
+ * Applies the given Move just like applyMove, but records what it changed so it can be taken back.
+ * @param move The Move to apply, which must start at a piece in this position.
+ * @param undo Filled with everything unmakeMove needs to restore this position
+ */
+void Position::makeMove(const Move& move, UndoRecord& undo)
+{
+    int from = move.getFrom();
+    int to = move.getTo();
+    bitboard_t jumped = move.getJumped();
+
+    bitboard_t fromBit = 1u << from;
+    bool isWhite = (whitePieces & fromBit) != 0;
+    bool isKing = (kings & fromBit) != 0;
+
+    undo.from = (uint8_t)from;
+    undo.to = (uint8_t)to;
+    undo.jumped = jumped;
+    undo.jumpedKings = jumped & kings;
+    undo.oldKey = key;
+    undo.oldPieceScore = pieceScore;
+
+    // remove jumped pieces and move this one
+    while (jumped)
+        clearSquare(popSquare(jumped));
+    clearSquare(from);
+
+    // crown it if it made it to the other side
+    undo.crowned = move.isCrowning();
+    if (undo.crowned)
+        isKing = true;
+
+    setPiece(to, isWhite, isKing);
+    setWhiteToMove(!isWhite);
+}
+
+/**
+ * Takes back the last move made with makeMove, restoring this position exactly.
+ * @param undo The record filled in when the move was made
+ */
+void Position::unmakeMove(const UndoRecord& undo)
+{
+    // the side to move now is the side that didn't move, so the jumped pieces were theirs
+    bitboard_t fromBit = 1u << undo.from;
+    bitboard_t toBit = 1u << undo.to;
+    bitboard_t& movers = whiteToMove ? blackPieces : whitePieces;
+    bitboard_t& opponents = whiteToMove ? whitePieces : blackPieces;
+
+    movers = (movers & ~toBit) | fromBit;
+    if (kings & toBit)
+        kings = (kings & ~toBit) | (undo.crowned ? 0 : fromBit);
+
+    opponents |= undo.jumped;
+    kings |= undo.jumpedKings;
+
+    // the key and piece score aren't worth updating piece by piece, since we know exactly what they were
+    key = undo.oldKey;
+    pieceScore = undo.oldPieceScore;
+    whiteToMove = !whiteToMove;
+}
+
+/**
+ * @return Returns the pieces of the given side which can move in the given direction
+ * (all kings, but only men moving forward)
+ * @param isWhite The side to look at
+ * @param direction The direction to move in
+ */
+bitboard_t Position::getPiecesMovingIn(bool isWhite, int direction) const
+{
+    bool isForward = isWhite ? (direction == DOWN_LEFT || direction == DOWN_RIGHT)
+                             : (direction == UP_LEFT || direction == UP_RIGHT);
+    return isForward ? getPieces(isWhite) : getPieces(isWhite) & kings;
+}
+
+/**
+ * Finds every piece of a side that has a non-jumping move, using one shift per direction.
+ * @param isWhite The side to look at
+ * @return Returns a bitboard of those pieces
+ */
+bitboard_t Position::getMovablePieces(bool isWhite) const
+{
+    bitboard_t empty = getEmptySquares();
+    bitboard_t movable = 0;
+
+    // shift the empty squares backwards; any piece they land on can move into them
+    // (the opposite direction is always the other end of the enum)
+    for (int direction = UP_LEFT; direction <= DOWN_RIGHT; direction++)
+        movable |= shift(empty, DOWN_RIGHT - direction) & getPiecesMovingIn(isWhite, direction);
+
+    return movable;
+}
+
+/**
+ * Finds every piece of a side that can jump an opposing piece, using two shifts per direction.
+ * @param isWhite The side to look at
+ * @return Returns a bitboard of those pieces
+ */
+bitboard_t Position::getJumpingPieces(bool isWhite) const
+{
+    bitboard_t empty = getEmptySquares();
+    bitboard_t opponents = getPieces(!isWhite);
+    bitboard_t jumping = 0;
+
+    for (int direction = UP_LEFT; direction <= DOWN_RIGHT; direction++)
+    {
+        int backwards = DOWN_RIGHT - direction;
+
+        // opponents with an empty space behind them, then the spaces in front of those opponents
+        bitboard_t jumpable = shift(empty, backwards) & opponents;
+        jumping |= shift(jumpable, backwards) & getPiecesMovingIn(isWhite, direction);
+    }
+
+    return jumping;
+}
+
+/**
+ * Generates all physically possible moves of the piece on the given square,
+ * including each individual one involved in every jump, and adds them to the list.
+ * @param square The square of the piece to move (must hold a piece)
+ * @param moves The list to add the moves to
+ */
+void Position::getPieceMoves(int square, moves_t& moves) const
+{
+    bitboard_t bit = 1u << square;
+    bool isWhite = (whitePieces & bit) != 0;
+    bool isKing = (kings & bit) != 0;
+    bitboard_t kingRow = isKing ? 0 : isWhite ? WHITE_KING_ROW : BLACK_KING_ROW;
+    bitboard_t empty = getEmptySquares();
+
+    for (int direction = UP_LEFT; direction <= DOWN_RIGHT; direction++)
+    {
+        // men can only move forward
+        if (!(getPiecesMovingIn(isWhite, direction) & bit))
+            continue;
+
+        bitboard_t target = shift(bit, direction) & empty;
+        if (target)
+        {
+            bool crowns = (target & kingRow) != 0;
+            moves.push_back(Move(square, popSquare(target), 0, crowns));
+        }
+    }
+
+    // after we've checked all normal moves, add all possible jumps (recusively as well - I mean ALL jumps)
+    addJumps(square, square, isWhite, isKing, 0, moves);
+}
+
+/**
+ * Generates all jumping moves of the piece on the given square (recursively, so including
+ * every step of multiple jumps) and adds them to the list.
+ * @param square The square of the piece to move (must hold a piece)
+ * @param moves The list to add the moves to
+ */
+void Position::getPieceJumps(int square, moves_t& moves) const
+{
+    bitboard_t bit = 1u << square;
+    addJumps(square, square, (whitePieces & bit) != 0, (kings & bit) != 0, 0, moves);
+}
+
+/**
+ * @return Returns true if the list already has the given move
+ * @param moves The list, which the move would be added to the end of
+ * @param move The move
+ */
+static bool hasMove(const moves_t& moves, const Move& move)
+{
+    // (a piece's moves are all added together, so only those at the end can be from the same square)
+    for (unsigned int i = moves.size(); i-- > 0 && moves[i].getFrom() == move.getFrom();)
+    {
+        if (moves[i] == move)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Recursively finds all jumps that continue on from a piece at the given square.
+ * @param origin The square the jumping piece started on
+ * @param square The square the (possibly imaginary) jumping piece is currently on
+ * @param isWhite The color of the jumping piece
+ * @param isKing Whether the jumping piece is a king
+ * @param jumped A bitboard of the pieces already jumped (which can't be jumped again)
+ * @param moves The list to add the moves to
+ */
+void Position::addJumps(int origin, int square, bool isWhite, bool isKing, bitboard_t jumped, moves_t& moves) const
+{
+    bitboard_t bit = 1u << square;
+    bitboard_t opponents = getPieces(!isWhite) & ~jumped;
+    bitboard_t kingRow = isKing ? 0 : isWhite ? WHITE_KING_ROW : BLACK_KING_ROW;
+    bitboard_t empty = getEmptySquares();
+
+    for (int direction = UP_LEFT; direction <= DOWN_RIGHT; direction++)
+    {
+        // men can only jump forward (we check the direction against the color, not the
+        // piece here, because this may be an imaginary piece partway through a jump)
+        bool isForward = isWhite ? direction >= DOWN_LEFT : direction <= UP_RIGHT;
+        if (!isKing && !isForward)
+            continue;
+
+        // there must be an opponent we haven't jumped yet next to us, with an empty space behind it
+        bitboard_t over = shift(bit, direction) & opponents;
+        bitboard_t landing = shift(over, direction) & empty;
+        if (!landing)
+            continue;
+
+        // add this jump (with every piece jumped since the origin), then look for more from where it lands
+        bool crowns = (landing & kingRow) != 0;
+        int landingSquare = popSquare(landing);
+        Move jump(origin, landingSquare, jumped | over, crowns);
+
+        // a king can jump the same pieces in a different order and land in the same place, which is the same
+        // move (with the same jumps after it), so it is only added the first time
+        if (isKing && hasMove(moves, jump))
+            continue;
+
+        moves.push_back(jump);
+        addJumps(origin, landingSquare, isWhite, isKing, jumped | over, moves);
+    }
+}
+
+/**
+ * Generates every legal move for the given side in one pass. A side that can jump has to, so if it
+ * has any jumps only they are generated (every step of every jump, with each one reached by more
+ * than one path only once), and otherwise every non-jumping move is, with one shift per direction.
+ * @param isWhite The side to move
+ * @param moves The list to add the moves to
+ */
+void Position::getMoves(bool isWhite, moves_t& moves) const
+{
+    bitboard_t jumping = getJumpingPieces(isWhite);
+    if (jumping)
+    {
+        while (jumping)
+        {
+            int square = popSquare(jumping);
+            addJumps(square, square, isWhite, (kings & (1u << square)) != 0, 0, moves);
+        }
+        return;
+    }
+
+    // every piece that can step into an empty square in each direction, all at once (just like getMovablePieces)
+    bitboard_t empty = getEmptySquares();
+    bitboard_t kingRow = isWhite ? WHITE_KING_ROW : BLACK_KING_ROW;
+    for (int direction = UP_LEFT; direction <= DOWN_RIGHT; direction++)
+    {
+        bitboard_t moving = shift(empty, DOWN_RIGHT - direction) & getPiecesMovingIn(isWhite, direction);
+        while (moving)
+        {
+            int from = popSquare(moving);
+            bitboard_t target = shift(1u << from, direction);
+
+            // only men are crowned
+            bool crowns = (target & kingRow) != 0 && !(kings & (1u << from));
+            moves.push_back(Move(from, popSquare(target), 0, crowns));
+        }
+    }
+}
+
+/**
+ * Generates only the jumps of the side to move (every step of every jump, just as getMoves does),
+ * looking only at the pieces that can jump.
+ * @param moves The list to add the jumps to
+ */
+void Position::getJumps(moves_t& moves) const
+{
+    bitboard_t pieces = getJumpingPieces(whiteToMove);
+    while (pieces)
+    {
+        int square = popSquare(pieces);
+        bitboard_t bit = 1u << square;
+        addJumps(square, square, whiteToMove, (kings & bit) != 0, 0, moves);
+    }
+}
+
+/**
+ * Finds the move for the side to move that the given notation describes, such as "9-13" for a
+ * normal move, or "9x18x27" (or just "9x27") for a jump.
+ * @param notation The move in checkers notation
+ * @param move Set to the move, if it is found
+ * @return Returns true if there is such a move
+ */
+bool Position::findMove(const std::string& notation, Move& move) const
+{
+    return findMove(notation.data(), notation.size(), move);
+}
+
+/**
+ * Finds the move for the side to move that the given notation describes, just like the other
+ * findMove, but reading straight from the text without allocating anything.
+ * @param notation The move in checkers notation, which doesn't need to end in a null
+ * @param length The number of characters in it
+ * @param move Set to the move, if it is found
+ * @return Returns true if there is such a move
+ */
+bool Position::findMove(const char* notation, size_t length, Move& move) const
+{
+    // read the squares the move passes through
+    int squares[SQUARES];
+    int count = 0;
+    bool isJump = false, isStep = false;
+    const char* at = notation;
+    const char* end = notation + length;
+    while (true)
+    {
+        int number;
+        if (count == SQUARES || !readNotationNumber(at, end, number))
+            return false;
+        squares[count++] = getSquareFromNotation(number);
+
+        if (at == end)
+            break;
+        else if (*at == 'x')
+            isJump = true;
+        else if (*at == '-')
+            isStep = true;
+        else
+            return false;
+        at++;
+    }
+    if (count < 2 || (isJump && isStep) || (isStep && count > 2))
+        return false;
+
+    // work out which pieces the whole path jumps, if every hop of it is written out
+    bitboard_t jumped = 0;
+    bool isFullPath = isJump;
+    for (int i = 0; isJump && i + 1 < count; i++)
+    {
+        coords_t from = getCoordsFromSquare(squares[i]);
+        coords_t to = getCoordsFromSquare(squares[i + 1]);
+        if (std::abs(to[0] - from[0]) != 2 || std::abs(to[1] - from[1]) != 2)
+            isFullPath = false;
+        else
+            jumped |= 1u << getSquare((from[0] + to[0]) / 2, (from[1] + to[1]) / 2);
+    }
+    if (isJump && count > 2 && !isFullPath)
+        return false;
+
+    moves_t moves;
+    getMoves(moves);
+
+    // a jump can also be written with just its first and last squares
+    // (but the full path of a move always wins, since a longer jump can start and end in the same places)
+    bool found = false;
+    for (unsigned int i = 0; i < moves.size(); i++)
+    {
+        if (moves[i].getFrom() != squares[0] || moves[i].getTo() != squares[count - 1] ||
+            moves[i].isJumpMove() != isJump)
+            continue;
+
+        if (!isJump || (isFullPath && moves[i].getJumped() == jumped))
+        {
+            move = moves[i];
+            return true;
+        }
+        if (!found && count == 2)
+        {
+            move = moves[i];
+            found = true;
+        }
+    }
+    return found;
+}
+
+/**
+ * Sets up this position from FEN notation, such as "W:W1,2,K7:B30,31", which gives the side to
+ * move, then the White and Black pieces by their notation numbers (with K before a king).
+ * A run of squares can also be written as a range, like "B21-32", and a final "." is ignored.
+ * This reads straight from the text, without allocating anything.
+ * @param fen The FEN, which doesn't need to end in a null
+ * @param length The number of characters in it
+ * @return Returns false (leaving this position unchanged) if the FEN isn't a valid position
+ */
+bool Position::setFromFen(const char* fen, size_t length)
+{
+    const char* at = fen;
+    const char* end = fen + length;
+    while (at < end && (*at == ' ' || *at == '\t'))
+        at++;
+    while (end > at && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r' || end[-1] == '\n' || end[-1] == '.'))
+        end--;
+
+    if (at == end || (*at != 'W' && *at != 'B'))
+        return false;
+
+    Position position;
+    position.setWhiteToMove(*at++ == 'W');
+
+    // then each side's pieces, after a colon
+    while (at < end)
+    {
+        if (*at++ != ':' || at == end || (*at != 'W' && *at != 'B'))
+            return false;
+        bool isWhite = *at++ == 'W';
+
+        while (at < end && *at != ':')
+        {
+            bool isKing = *at == 'K';
+            if (isKing)
+                at++;
+
+            int first, last;
+            if (!readNotationNumber(at, end, first))
+                return false;
+            last = first;
+            if (at < end && *at == '-')
+            {
+                at++;
+                if (!readNotationNumber(at, end, last) || last < first)
+                    return false;
+            }
+
+            for (int number = first; number <= last; number++)
+            {
+                // a man can't stand on the row it would have been crowned on, and squares can't be shared
+                bitboard_t bit = 1u << getSquareFromNotation(number);
+                if (((position.whitePieces | position.blackPieces) & bit) ||
+                    (!isKing && (bit & (isWhite ? WHITE_KING_ROW : BLACK_KING_ROW))))
+                    return false;
+                position.setPiece(getSquareFromNotation(number), isWhite, isKing);
+            }
+
+            // squares are separated by commas (with nothing after the last one)
+            if (at < end && *at == ',')
+            {
+                at++;
+                if (at == end || *at == ':')
+                    return false;
+            }
+            else if (at < end && *at != ':')
+                return false;
+        }
+    }
+
+    *this = position;
+    return true;
+}
+
+/**
+ * Writes this position in FEN notation (see setFromFen), with each side's pieces in order
+ * and no ranges, so the same position is always written the same way.
+ * @param buffer Where to write the FEN, followed by a null
+ * @param size The size of the buffer (MAX_FEN_LENGTH + 1 is always enough)
+ * @return Returns the length of the FEN, or 0 if it didn't fit (in which case nothing is written)
+ */
+size_t Position::writeFen(char* buffer, size_t size) const
+{
+    char fen[MAX_FEN_LENGTH + 1];
+    char* at = fen;
+    *at++ = whiteToMove ? 'W' : 'B';
+
+    for (int side = 0; side < 2; side++)
+    {
+        bool isWhite = side == 0;
+        bitboard_t pieces = getPieces(isWhite);
+        *at++ = ':';
+        *at++ = isWhite ? 'W' : 'B';
+
+        bool first = true;
+        for (int number = 1; number <= SQUARES; number++)
+        {
+            bitboard_t bit = 1u << getSquareFromNotation(number);
+            if (!(pieces & bit))
+                continue;
+
+            if (!first)
+                *at++ = ',';
+            first = false;
+
+            if (kings & bit)
+                *at++ = 'K';
+            writeNotationNumber(number, at);
+        }
+    }
+
+    size_t length = at - fen;
+    if (length + 1 > size)
+        return 0;
+    std::memcpy(buffer, fen, length);
+    buffer[length] = '\0';
+    return length;
+}
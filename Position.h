@@ -0,0 +1,331 @@
+#ifndef POSITION_H
+#define POSITION_H
+
+#include "Typedefs.h"
+#include "MoveList.h"
+
+#include <string>
+
+/**
+ * Everything needed to take back a move made on a Position: where the piece came from and went,
+ * the pieces it jumped (and which of them were kings), whether it was crowned, and the old key and piece score.
+ */
+struct UndoRecord
+{
+	bitboard_t jumped;
+	bitboard_t jumpedKings;
+	uint64_t oldKey;
+	int oldPieceScore;
+	uint8_t from;
+	uint8_t to;
+	bool crowned;
+};
+
+/**
+ * Stores the pieces on the board as bitboards, with one bit for each of the 32 checkerboard
+ * spaces and seperate masks for the white pieces, the black pieces and the kings.
+ * The squares are numbered 0-31 from the top left to the bottom right, four per row,
+ * so that a whole side's pieces can be moved diagonally with a single shift and mask.
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+class Position
+{
+    public:
+    	const static int SQUARES = 32;
+
+    	// the longest a position can be in FEN (see setFromFen), not counting the terminating null
+    	const static size_t MAX_FEN_LENGTH = 136;
+
+    	// the starting position, in FEN
+    	static const char* const START_FEN;
+
+    	// the four diagonal directions pieces can move in (white men move down, black men up)
+    	enum Direction { UP_LEFT = 0, UP_RIGHT = 1, DOWN_LEFT = 2, DOWN_RIGHT = 3 };
+
+		/**
+		 * Responsible for generating an empty position (with white to move, as white moves first)
+		 */
+		Position() : whitePieces(0), blackPieces(0), kings(0), whiteToMove(true), key(0), pieceScore(0) {};
+
+		/**
+		 * @return Returns the square number of the given coordinates,
+		 * or -1 if they are not a checkerboard space on the board.
+		 * @param x The x coordinate
+		 * @param y The y coordinate
+		 */
+		static int getSquare(int x, int y)
+		{
+			// (the board is eight spaces wide, and there are four squares per row, so the low bit of x is dropped)
+			return x < 0 || x >= 8 || y < 0 || y >= 8 || x % 2 != y % 2 ? -1 : y * (SQUARES / 8) + x / 2;
+		}
+
+		/**
+		 * Converts a square number to x and y coordinates.
+		 * @param square The square number, 0-31.
+		 * @return A two part int array where [0] is the x coordinate and [1] is the y.
+		 */
+		static coords_t getCoordsFromSquare(int square);
+
+		/**
+		 * Shifts every square in the given bitboard one space in the given direction,
+		 * dropping any that would fall off the edge of the board.
+		 * @param squares The bitboard to shift
+		 * @param direction The Direction to shift in
+		 * @return Returns the shifted bitboard
+		 */
+		static bitboard_t shift(bitboard_t squares, int direction)
+		{
+			// because odd rows are offset one space to the right, the same diagonal is a shift
+			// of 3, 4 or 5 depending on the row, and shifts off the top or bottom just fall away
+			switch (direction)
+			{
+				case UP_LEFT:
+					return ((squares & EVEN_ROWS & ~LEFT_EDGE) >> 5) | ((squares & ODD_ROWS) >> 4);
+				case UP_RIGHT:
+					return ((squares & EVEN_ROWS) >> 4) | ((squares & ODD_ROWS & ~RIGHT_EDGE) >> 3);
+				case DOWN_LEFT:
+					return ((squares & EVEN_ROWS & ~LEFT_EDGE) << 3) | ((squares & ODD_ROWS) << 4);
+				default: // DOWN_RIGHT
+					return ((squares & EVEN_ROWS) << 4) | ((squares & ODD_ROWS & ~RIGHT_EDGE) << 5);
+			}
+		}
+
+		/**
+		 * @return Returns the lowest square in the bitboard, and removes it from the bitboard
+		 * @param squares A (non-empty) bitboard
+		 */
+		static int popSquare(bitboard_t& squares)
+		{ int square = __builtin_ctz(squares); squares &= squares - 1; return square; }
+
+		/**
+		 * @return Returns the number of squares set in the given bitboard
+		 */
+		static int countSquares(bitboard_t squares) { return __builtin_popcount(squares); }
+
+		/**
+		 * Converts a square to the number used for it in checkers notation (1-32).
+		 * This is the standard numbering, where the side that moves first starts on 1-12,
+		 * which runs right to left across our rows (the board is a mirror image of the usual diagram).
+		 * @param square The square number, 0-31
+		 * @return Returns the notation number
+		 */
+		static int getNotationNumber(int square) { return square - 2 * (square % 4) + 4; }
+
+		/**
+		 * Converts a number used in checkers notation (1-32) back to a square.
+		 * @param number The notation number
+		 * @return Returns the square number, or -1 if the number isn't on the board
+		 */
+		static int getSquareFromNotation(int number)
+		{ return number < 1 || number > SQUARES ? -1 : number + 2 - 2 * ((number - 1) % 4); }
+
+		/**
+		 * @return Returns all pieces of the given color
+		 * @param isWhite The color of the pieces
+		 */
+		bitboard_t getPieces(bool isWhite) const { return isWhite ? whitePieces : blackPieces; }
+
+		/**
+		 * @return Returns all kings, of both colors
+		 */
+		bitboard_t getKings() const { return kings; }
+
+		/**
+		 * @return Returns all spaces on the board without a piece
+		 */
+		bitboard_t getEmptySquares() const { return ~(whitePieces | blackPieces); }
+
+		/**
+		 * @return Returns true if it is white's turn to move
+		 */
+		bool isWhiteToMove() const { return whiteToMove; }
+
+		/**
+		 * Sets whose turn it is to move.
+		 * @param isWhite True if it should be white's turn
+		 */
+		void setWhiteToMove(bool isWhite);
+
+		/**
+		 * @return Returns the Zobrist key of this position (see Zobrist.h), which is kept up to date
+		 * as pieces are placed and moved rather than being recalculated.
+		 */
+		uint64_t getKey() const { return key; }
+
+		/**
+		 * @return Returns the sum of the values of every piece where it stands (see Evaluator::getPieceValue),
+		 * from White's point of view, which is kept up to date as pieces are placed and moved just like the key.
+		 */
+		int getPieceScore() const { return pieceScore; }
+
+		/**
+		 * Places a piece on the given square (replacing anything already there).
+		 * @param square The square number
+		 * @param isWhite The color of the piece
+		 * @param isKing Whether the piece is a king
+		 */
+		void setPiece(int square, bool isWhite, bool isKing);
+
+		/**
+		 * Removes any piece from the given square.
+		 * @param square The square number
+		 */
+		void clearSquare(int square);
+
+		/**
+		 * Applies the given Move (including all pieces it jumps) to this position,
+		 * crowning the moving piece if it reaches the far side of the board, and passes the turn.
+		 * @param move The Move to apply, which must start at a piece in this position.
+		 */
+		void applyMove(const Move& move);
+
+		/**
+		 * Applies the given Move just like applyMove, but records what it changed so it can be taken back.
+		 * (This lets a search try moves on a single position instead of copying it)
+		 * @param move The Move to apply, which must start at a piece in this position.
+		 * @param undo Filled with everything unmakeMove needs to restore this position
+		 */
+		void makeMove(const Move& move, UndoRecord& undo);
+
+		/**
+		 * Takes back the last move made with makeMove, restoring this position exactly.
+		 * @param undo The record filled in when the move was made
+		 */
+		void unmakeMove(const UndoRecord& undo);
+
+		/**
+		 * Finds every piece of a side that has a non-jumping move, using one shift per direction.
+		 * @param isWhite The side to look at
+		 * @return Returns a bitboard of those pieces
+		 */
+		bitboard_t getMovablePieces(bool isWhite) const;
+
+		/**
+		 * Finds every piece of a side that can jump an opposing piece, using two shifts per direction.
+		 * @param isWhite The side to look at
+		 * @return Returns a bitboard of those pieces
+		 */
+		bitboard_t getJumpingPieces(bool isWhite) const;
+
+		/**
+		 * @return Returns true if the given side has any move at all (jumping or not)
+		 * @param isWhite The side to look at
+		 */
+		bool hasMoves(bool isWhite) const { return (getMovablePieces(isWhite) | getJumpingPieces(isWhite)) != 0; }
+
+		/**
+		 * Generates all physically possible moves of the piece on the given square,
+		 * including each individual one involved in every jump, and adds them to the list.
+		 * (These are all of the piece's moves, even if another piece has to jump instead - see getMoves)
+		 * @param square The square of the piece to move (must hold a piece)
+		 * @param moves The list to add the moves to
+		 */
+		void getPieceMoves(int square, moves_t& moves) const;
+
+		/**
+		 * Generates all jumping moves of the piece on the given square (recursively, so including
+		 * every step of multiple jumps) and adds them to the list.
+		 * @param square The square of the piece to move (must hold a piece)
+		 * @param moves The list to add the moves to
+		 */
+		void getPieceJumps(int square, moves_t& moves) const;
+
+		/**
+		 * Generates every legal move for the side to move (see the other getMoves).
+		 * @param moves The list to add the moves to
+		 */
+		void getMoves(moves_t& moves) const { getMoves(whiteToMove, moves); }
+
+		/**
+		 * Generates every legal move for the given side in one pass. A side that can jump has to, so if it
+		 * has any jumps only they are generated (every step of every jump, with each one reached by more
+		 * than one path only once), and otherwise every non-jumping move is, with one shift per direction.
+		 * @param isWhite The side to move
+		 * @param moves The list to add the moves to
+		 */
+		void getMoves(bool isWhite, moves_t& moves) const;
+
+		/**
+		 * Generates only the jumps of the side to move (every step of every jump, just as getMoves does),
+		 * looking only at the pieces that can jump.
+		 * @param moves The list to add the jumps to
+		 */
+		void getJumps(moves_t& moves) const;
+
+		/**
+		 * Finds the move for the side to move that the given notation describes, such as "9-13" for a
+		 * normal move, or "9x18x27" (or just "9x27") for a jump.
+		 * @param notation The move in checkers notation
+		 * @param move Set to the move, if it is found
+		 * @return Returns true if there is such a move
+		 */
+		bool findMove(const std::string& notation, Move& move) const;
+
+		/**
+		 * Finds the move for the side to move that the given notation describes, just like the other
+		 * findMove, but reading straight from the text without allocating anything.
+		 * @param notation The move in checkers notation, which doesn't need to end in a null
+		 * @param length The number of characters in it
+		 * @param move Set to the move, if it is found
+		 * @return Returns true if there is such a move
+		 */
+		bool findMove(const char* notation, size_t length, Move& move) const;
+
+		/**
+		 * Sets up this position from FEN notation, such as "W:W1,2,K7:B30,31", which gives the side to
+		 * move, then the White and Black pieces by their notation numbers (with K before a king).
+		 * A run of squares can also be written as a range, like "B21-32", and a final "." is ignored.
+		 * This reads straight from the text, without allocating anything.
+		 * @param fen The FEN, which doesn't need to end in a null
+		 * @param length The number of characters in it
+		 * @return Returns false (leaving this position unchanged) if the FEN isn't a valid position
+		 */
+		bool setFromFen(const char* fen, size_t length);
+
+		/**
+		 * Writes this position in FEN notation (see setFromFen), with each side's pieces in order
+		 * and no ranges, so the same position is always written the same way.
+		 * @param buffer Where to write the FEN, followed by a null
+		 * @param size The size of the buffer (MAX_FEN_LENGTH + 1 is always enough)
+		 * @return Returns the length of the FEN, or 0 if it didn't fit (in which case nothing is written)
+		 */
+		size_t writeFen(char* buffer, size_t size) const;
+
+	private:
+		// masks used to keep shifts from wrapping around the sides of the board
+		// (rows alternate between starting on the left edge and ending on the right edge)
+		const static bitboard_t EVEN_ROWS = 0x0F0F0F0F;
+		const static bitboard_t ODD_ROWS = 0xF0F0F0F0;
+		const static bitboard_t LEFT_EDGE = 0x01010101;  // first square of each even row
+		const static bitboard_t RIGHT_EDGE = 0x80808080; // last square of each odd row
+
+		bitboard_t whitePieces;
+		bitboard_t blackPieces;
+		bitboard_t kings;
+		bool whiteToMove;
+		uint64_t key;
+		int pieceScore;
+
+		/**
+		 * @return Returns the pieces of the given side which can move in the given direction
+		 * (all kings, but only men moving forward)
+		 * @param isWhite The side to look at
+		 * @param direction The direction to move in
+		 */
+		bitboard_t getPiecesMovingIn(bool isWhite, int direction) const;
+
+		/**
+		 * Recursively finds all jumps that continue on from a piece at the given square.
+		 * @param origin The square the jumping piece started on
+		 * @param square The square the (possibly imaginary) jumping piece is currently on
+		 * @param isWhite The color of the jumping piece
+		 * @param isKing Whether the jumping piece is a king
+		 * @param jumped A bitboard of the pieces already jumped (which can't be jumped again)
+		 * @param moves The list to add the moves to
+		 */
+		void addJumps(int origin, int square, bool isWhite, bool isKing, bitboard_t jumped, moves_t& moves) const;
+};
+
+#endif
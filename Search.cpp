@@ -0,0 +1,576 @@
+#include "Search.h"
+
+#include "Board.h"
+#include "Evaluator.h"
+#include "Position.h"
+#include "Move.h"
+#include "MoveList.h"
+#include "Arena.h"
+#include "MovePicker.h"
+#include "TranspositionTable.h"
+#include "Tablebase.h"
+#include "Typedefs.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <vector>
+#include <thread>
+
+// how many positions a thread counts before reporting them (and looking at the clock, which at a few
+// million positions a second is still several times a millisecond)
+static const long long NODE_BATCH = 1024;
+
+// the moves a clock is budgeted to last for, if it isn't topped up sooner
+static const int EXPECTED_MOVES = 30;
+
+// the milliseconds kept back on the clock for everything besides searching (like sending the move)
+static const int MOVE_OVERHEAD = 20;
+
+// how many times its soft limit a search may take to finish the iteration it started
+static const int HARD_LIMIT_FACTOR = 4;
+
+// the most plies of jumps a quiescence search can go past the end of a line (each jump takes at least one of the pieces)
+static const int MAX_CAPTURE_PLIES = 24;
+
+// once any history score reaches this, they are all halved (so they can't overflow, and older cutoffs count for less)
+static const int MAX_HISTORY = 1 << 24;
+
+const int Search::MAX_DEPTH;
+
+// any score past this is a won or lost game, which is stored in the transposition table relative to
+// the position (not the root) so it stays correct when the position is reached at a different ply
+static const int WIN_THRESHOLD = Search::WIN_SCORE - 1000;
+
+/**
+ * @return Returns the milliseconds since the given time
+ */
+static double getMillisecondsSince(std::chrono::steady_clock::time_point time)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time).count();
+}
+
+/**
+ * @return Returns the score converted to be stored in the transposition table
+ */
+static int scoreToTable(int score, int ply)
+{
+    if (score >= WIN_THRESHOLD) return score + ply;
+    if (score <= -WIN_THRESHOLD) return score - ply;
+    return score;
+}
+
+/**
+ * @return Returns the score converted back from being stored in the transposition table
+ */
+static int scoreFromTable(int score, int ply)
+{
+    if (score >= WIN_THRESHOLD) return score - ply;
+    if (score <= -WIN_THRESHOLD) return score + ply;
+    return score;
+}
+
+/**
+ * Encodes a move compactly (for the transposition table) by its starting and ending squares.
+ * @param move The move to encode
+ * @return Returns the encoded move, which is never 0
+ */
+uint16_t Search::encodeMove(const Move& move)
+{
+    // five bits for each square, with the top bit set so no move encodes to zero
+    return move.getFrom() | move.getTo() << 5 | 0x8000;
+}
+
+/**
+ * Works out how long a search with the given limits may take, from its movetime and clock.
+ * @param limits The limits
+ * @param soft Set to the milliseconds after which no new iteration is started (0 if it isn't timed)
+ * @param hard Set to the milliseconds after which the search stops, even partway through an iteration
+ * (0 if it isn't timed)
+ */
+void Search::getTimeLimits(const SearchLimits& limits, int& soft, int& hard)
+{
+    soft = hard = 0;
+    if (limits.time > 0)
+    {
+        // share what is left between the moves it has to last, counting on every increment still to come,
+        // but never let one move take more than half of it, unless it's the last before the clock is topped up
+        int available = std::max(limits.time - MOVE_OVERHEAD, 1);
+        int moves = limits.movesToGo > 0 ? std::min(limits.movesToGo, EXPECTED_MOVES) : EXPECTED_MOVES;
+        int limit = moves == 1 ? available : std::max(available / 2, 1);
+        soft = std::min(available / moves + limits.increment, limit);
+        hard = std::min(soft * HARD_LIMIT_FACTOR, limit);
+    }
+    if (limits.movetime > 0)
+    {
+        soft = soft > 0 ? std::min(soft, limits.movetime) : limits.movetime;
+        hard = hard > 0 ? std::min(hard, limits.movetime) : limits.movetime;
+    }
+}
+
+/**
+ * Searches the given position one ply deeper at a time, until the depth, node or time limit is reached.
+ * The first iteration is always finished (it takes next to no time), so there is always a move to play.
+ * @param position The position to search, which decides whose move it is
+ * @param limits The limits to stop searching at
+ * @return Returns the result of the deepest completed iteration (or, if it was stopped before
+ * completing any, just the first of the moves)
+ */
+SearchResult Search::run(const Position& position, const SearchLimits& limits)
+{
+    stopped = stopRequested.load();
+    sharedNodes = 0;
+    maxNodes = 0; // don't let the node or time limit interrupt the first iteration
+    timeLimited = false;
+    completedDepth = 0;
+    start = std::chrono::steady_clock::now();
+    {
+        // a pondering search has no limits until it is hit (unless that already happened)
+        std::lock_guard<std::mutex> lock(limitsLock);
+        SearchLimits unlimited;
+        unlimited.depth = 0;
+        setLimits(hitLimitsGiven ? hitLimits : pondering ? unlimited : limits);
+    }
+    table.newSearch();
+
+    std::vector<Worker> workers(threads);
+    for (int i = 0; i < threads; i++)
+    {
+        workers[i].id = i;
+        workers[i].stats = SearchStats();
+        workers[i].unreported = 0;
+        std::fill(workers[i].killers[0], workers[i].killers[0] + (MAX_DEPTH + 1) * MovePicker::KILLERS, Move());
+        std::memset(workers[i].history, 0, sizeof(workers[i].history));
+
+        // each thread needs a list of moves and a line for every ply it can reach (and room to align them),
+        // and a list of jumps for every ply of a quiescence search past that
+        workers[i].arena.reserve((MAX_DEPTH + 1) * (sizeof(MoveList) + sizeof(Line) + 2 * alignof(Line)) +
+                                 MAX_CAPTURE_PLIES * (sizeof(MoveList) + alignof(MoveList)));
+    }
+
+    // start the helpers, then search on this thread too; the helpers only stop when we do
+    double setupMilliseconds = getMillisecondsSince(start);
+    std::vector<std::thread> helpers;
+    for (int i = 1; i < threads; i++)
+        helpers.push_back(std::thread(&Search::iterate, this, std::ref(workers[i]), std::cref(position)));
+
+    iterate(workers[0], position);
+
+    std::chrono::steady_clock::time_point finish = std::chrono::steady_clock::now();
+    stopped = true;
+    for (unsigned int i = 0; i < helpers.size(); i++)
+        helpers[i].join();
+    stopRequested = false;
+    {
+        std::lock_guard<std::mutex> lock(limitsLock);
+        hitLimitsGiven = false;
+    }
+
+    // use whichever thread got deepest (preferring the main thread), and count everyone's work
+    SearchResult result = workers[0].result;
+    SearchStats stats = workers[0].stats;
+    stats.threadNodes.assign(1, workers[0].stats.nodes);
+    for (int i = 1; i < threads; i++)
+    {
+        if (workers[i].result.depth > result.depth && !workers[i].result.bestMove.isNull())
+            result = workers[i].result;
+        stats.add(workers[i].stats);
+        stats.threadNodes.push_back(workers[i].stats.nodes);
+    }
+    stats.setupMilliseconds = setupMilliseconds;
+    stats.finishMilliseconds = getMillisecondsSince(finish);
+
+    // only a stop from another thread can end the first iteration early, and a move is still needed
+    if (result.bestMove.isNull())
+    {
+        MoveList moves;
+        position.getMoves(moves);
+        if (!moves.empty())
+        {
+            result.bestMove = moves[0];
+            result.pv.assign(1, moves[0]);
+        }
+    }
+
+    stats.milliseconds = getMillisecondsSince(start);
+    result.nodes = stats.nodes;
+    result.stats = stats;
+    return result;
+}
+
+/**
+ * Sets the limits the search stops at (which must be done holding limitsLock).
+ * @param limits The limits
+ */
+void Search::setLimits(const SearchLimits& limits)
+{
+    int soft, hard;
+    getTimeLimits(limits, soft, hard);
+    depthLimit = limits.depth;
+    nodeLimit = limits.nodes;
+    timed = limits.movetime > 0 || limits.time > 0;
+    softLimit = soft;
+    hardLimit = hard;
+}
+
+/**
+ * Runs the iterative deepening loop of a single thread, until it finishes or the search is stopped.
+ * @param worker The thread's own state, which receives its result
+ * @param position The position to search
+ */
+void Search::iterate(Worker& worker, const Position& position)
+{
+    Position root = position;
+
+    // helpers start at staggered depths so the threads spread out over different iterations
+    // (and may go a ply past the depth limit, which keeps them filling the table until the main thread is done)
+    int firstDepth = 1 + worker.id % 2;
+
+    for (int depth = firstDepth; depth <= MAX_DEPTH; depth++)
+    {
+        // (the limits are read again for every iteration, since a ponder hit can change them)
+        int lastDepth = depthLimit;
+        if (lastDepth > 0 && depth > lastDepth + (worker.id > 0 ? 1 : 0))
+            break;
+
+        std::chrono::steady_clock::time_point iterationStart = std::chrono::steady_clock::now();
+        Line pv;
+        int score = negamax(worker, root, depth, 0, -WIN_SCORE, WIN_SCORE, pv);
+        worker.stats.iterationMilliseconds.push_back(getMillisecondsSince(iterationStart));
+
+        // a stopped iteration is only partly searched, so fall back on the last complete one
+        if (stopped)
+            break;
+
+        worker.result.score = score;
+        worker.result.depth = depth;
+        worker.result.pv.assign(pv.moves, pv.moves + pv.length);
+        worker.result.bestMove = pv.length > 0 ? pv.moves[0] : Move();
+
+        if (worker.id == 0 && onIteration)
+        {
+            SearchResult progress = worker.result;
+            progress.nodes = sharedNodes + worker.unreported;
+            onIteration(progress);
+        }
+
+        // there's nothing more to learn if there are no moves, or the game is decided
+        if (pv.length == 0 || std::abs(score) >= WIN_SCORE - depth)
+            break;
+
+        if (worker.id == 0)
+        {
+            completedDepth = depth;
+            long long nodes = nodeLimit;
+            maxNodes = nodes;
+            if (nodes > 0 && sharedNodes + worker.unreported >= nodes)
+                break;
+
+            // (an iteration started after the soft deadline would likely be abandoned at the hard one)
+            timeLimited = timed.load();
+            if (timeLimited && isPast(softLimit))
+                break;
+        }
+    }
+}
+
+/**
+ * Stops the search that is running (from another thread), as soon as every thread notices.
+ * The search returns its last completed iteration. If it hasn't started yet, it stops as soon as it does.
+ */
+void Search::stop()
+{
+    stopRequested = true;
+    stopped = true;
+}
+
+/**
+ * Tells a pondering search (from another thread) that the opponent played the move it expected,
+ * so it carries on as a normal search with the given limits, its time counting from now.
+ * If it has already gone as deep or visited as many positions as they allow, it stops at once.
+ * @param limits The limits for the move (which may have changed since the search started)
+ */
+void Search::ponderHit(const SearchLimits& limits)
+{
+    std::lock_guard<std::mutex> lock(limitsLock);
+    hitLimits = limits;
+    hitLimitsGiven = true;
+    setLimits(limits);
+    ponderHitTime = std::chrono::steady_clock::now().time_since_epoch().count();
+    pondering = false;
+
+    // the main thread only checks the limits after each iteration, and never before the first is done
+    int depth = completedDepth;
+    if (depth > 0)
+    {
+        maxNodes = limits.nodes;
+        timeLimited = timed.load();
+        if ((limits.depth > 0 && depth >= limits.depth) || (limits.nodes > 0 && sharedNodes >= limits.nodes))
+            stop();
+    }
+}
+
+/**
+ * @return Returns true if the given time has passed since the search started (or since the ponder hit,
+ * if it pondered), and never while it is still pondering
+ * @param milliseconds The time
+ */
+bool Search::isPast(int milliseconds) const
+{
+    if (pondering)
+        return false;
+
+    // (a hit before the search even started counts from the start)
+    std::chrono::steady_clock::time_point hit{std::chrono::steady_clock::duration(ponderHitTime.load())};
+    return std::chrono::steady_clock::now() - std::max(start, hit) >= std::chrono::milliseconds(milliseconds);
+}
+
+/**
+ * Remembers a quiet move that caused a cutoff, so it is tried sooner elsewhere.
+ * @param worker The thread that searched it
+ * @param position The position the move was made in
+ * @param move The move
+ * @param depth The depth it was searched to
+ * @param ply The number of plies from the root
+ */
+void Search::rememberCutoff(Worker& worker, const Position& position, const Move& move, int depth, int ply)
+{
+    // the newest killer goes first, pushing out the oldest
+    Move* killers = worker.killers[ply];
+    if (killers[0] != move)
+    {
+        std::copy_backward(killers, killers + MovePicker::KILLERS - 1, killers + MovePicker::KILLERS);
+        killers[0] = move;
+    }
+
+    // deeper cutoffs saved more work, so they count for more
+    int (*history)[Position::SQUARES] = worker.history[position.isWhiteToMove() ? 0 : 1];
+    int& score = history[move.getFrom()][move.getTo()];
+    score += depth * depth;
+    if (score >= MAX_HISTORY)
+    {
+        int* scores = &worker.history[0][0][0];
+        for (unsigned int i = 0; i < sizeof(worker.history) / sizeof(int); i++)
+            scores[i] /= 2;
+    }
+}
+
+/**
+ * Counts a visited position, stopping the search if the node limit or hard deadline has been reached.
+ * @param worker The thread that visited it
+ */
+void Search::countNode(Worker& worker)
+{
+    worker.stats.nodes++;
+
+    // only touch the shared count every so often, so the threads don't fight over it
+    if (++worker.unreported >= NODE_BATCH)
+    {
+        long long total = sharedNodes.fetch_add(worker.unreported) + worker.unreported;
+        worker.unreported = 0;
+
+        long long limit = maxNodes;
+        if (limit > 0 && total >= limit)
+            stopped = true;
+        if (timeLimited && isPast(hardLimit))
+            stopped = true;
+    }
+}
+
+/**
+ * Searches the given position to the given depth, within the window of alpha and beta.
+ * @param worker The thread doing the searching
+ * @param position The position to search (moves are made and unmade on it, so it is unchanged afterwards)
+ * @param depth The number of plies left to search
+ * @param ply The number of plies from the root
+ * @param alpha The score the side to move is already guaranteed
+ * @param beta The score the opponent is already guaranteed (so anything above it is a cutoff)
+ * @param pv Filled with the best line found from this position
+ * @return Returns the score of the position for the side to move
+ */
+int Search::negamax(Worker& worker, Position& position, int depth, int ply, int alpha, int beta, Line& pv)
+{
+    countNode(worker);
+    pv.length = 0;
+
+    int gameOverScore;
+    if (isGameOver(position, ply, gameOverScore))
+        return gameOverScore;
+
+    // the endgame tables know exactly who wins and how soon, so these score just like wins the search
+    // found itself (at the root we still need a move, so always search)
+    if (tablebase != nullptr && ply > 0 && Position::countSquares(~position.getEmptySquares()) <= Tablebase::MAX_PIECES)
+    {
+        int distance;
+        int value = tablebase->probe(position, &distance);
+        if (value == Tablebase::WIN)
+            return WIN_SCORE - ply - distance;
+        else if (value == Tablebase::LOSS)
+            return -WIN_SCORE + ply + distance;
+        else if (value == Tablebase::DRAW)
+            return 0;
+    }
+
+    if (depth <= 0)
+        return quiesce(worker, position, ply, alpha, beta);
+
+    // see if we've already searched this position deeply enough to know what it's worth
+    // (at the root we still need a move, so always search)
+    TTEntry entry;
+    uint16_t tableMove = 0;
+    worker.stats.tableProbes++;
+    if (table.probe(position.getKey(), entry))
+    {
+        worker.stats.tableHits++;
+        tableMove = entry.move;
+        int score = scoreFromTable(entry.score, ply);
+        if (ply > 0 && entry.depth >= depth &&
+            (entry.bound == TranspositionTable::EXACT ||
+             (entry.bound == TranspositionTable::LOWER && score >= beta) ||
+             (entry.bound == TranspositionTable::UPPER && score <= alpha)))
+        {
+            worker.stats.tableCutoffs++;
+            return score;
+        }
+    }
+
+    // this node's moves, and the line after each of them, are scratch space from the thread's arena,
+    // which is all handed back at once when we return
+    Arena::Scope scratch(worker.arena);
+    moves_t& moves = worker.arena.create<moves_t>();
+    Line& childPv = worker.arena.create<Line>();
+
+    // the move that was best last time is tried first, since it will probably be best again
+    MovePicker picker(position, moves, tableMove, worker.killers[ply], worker.history);
+    worker.stats.moveGenerations++;
+
+    int originalAlpha = alpha;
+    int bestScore = -WIN_SCORE;
+    uint16_t bestMove = 0;
+    Move move;
+    for (int index = 0; picker.next(move); index++)
+    {
+        // a table move that isn't among the moves came from another position with the same key
+        if (index == 0 && tableMove != 0 && picker.getStage() != MovePicker::TABLE_MOVE)
+            worker.stats.tableCollisions++;
+
+        UndoRecord undo;
+        position.makeMove(move, undo);
+
+        int score = -negamax(worker, position, depth - 1, ply + 1, -beta, -alpha, childPv);
+        position.unmakeMove(undo);
+        if (stopped)
+            return 0;
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            bestMove = encodeMove(move);
+        }
+
+        if (score > alpha)
+        {
+            alpha = score;
+
+            // this move is the new best line, followed by the best line after it
+            pv.moves[0] = move;
+            std::copy(childPv.moves, childPv.moves + childPv.length, pv.moves + 1);
+            pv.length = childPv.length + 1;
+
+            // the opponent won't let us get here, so there's no point looking further
+            if (alpha >= beta)
+            {
+                worker.stats.cutoffs++;
+                worker.stats.cutoffsByIndex[std::min(index, SearchStats::CUTOFF_INDEXES - 1)]++;
+                worker.stats.cutoffsByStage[picker.getStage()]++;
+                if (!move.isJumpMove())
+                    rememberCutoff(worker, position, move, depth, ply);
+                break;
+            }
+        }
+    }
+
+    int bound = bestScore >= beta ? TranspositionTable::LOWER
+              : bestScore > originalAlpha ? TranspositionTable::EXACT : TranspositionTable::UPPER;
+    table.store(position.getKey(), depth, bound, scoreToTable(bestScore, ply), bestMove);
+
+    return bestScore;
+}
+
+/**
+ * Searches only the jumps of the given position (and of the positions they lead to), within the window
+ * of alpha and beta. A side that can jump has to, so only a side without jumps can stop and take the evaluation.
+ * @param worker The thread doing the searching
+ * @param position The position to search, in which the game isn't over
+ * (moves are made and unmade on it, so it is unchanged afterwards)
+ * @param ply The number of plies from the root
+ * @param alpha The score the side to move is already guaranteed
+ * @param beta The score the opponent is already guaranteed (so anything above it is a cutoff)
+ * @return Returns the score of the position for the side to move
+ */
+int Search::quiesce(Worker& worker, Position& position, int ply, int alpha, int beta)
+{
+    countNode(worker);
+    worker.stats.quiescenceNodes++;
+
+    // a quiet position is scored as it stands (and the game isn't over, so a side that can't jump can move)
+    if (!position.getJumpingPieces(position.isWhiteToMove()))
+    {
+        worker.stats.evaluations++;
+        return Evaluator::evaluate(position);
+    }
+
+    // but otherwise the side to move has to jump, so it gets the best of its jumps, however bad they are
+    int bestScore = -WIN_SCORE;
+    Arena::Scope scratch(worker.arena);
+    moves_t& moves = worker.arena.create<moves_t>();
+    MovePicker picker(position, moves);
+    worker.stats.moveGenerations++;
+
+    Move move;
+    while (picker.next(move))
+    {
+        UndoRecord undo;
+        position.makeMove(move, undo);
+        int score;
+        if (isGameOver(position, ply + 1, score))
+            score = -score;
+        else
+            score = -quiesce(worker, position, ply + 1, -beta, -alpha);
+        position.unmakeMove(undo);
+        if (stopped)
+            return 0;
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            if (score >= beta)
+                break;
+            alpha = std::max(alpha, score);
+        }
+    }
+    return bestScore;
+}
+
+/**
+ * Checks whether the game is over in the given position (because either side can't move, though at
+ * the root only the side to move running out of moves counts, since a move is still needed).
+ * @param position The position
+ * @param ply The number of plies from the root
+ * @param score Set to the score of the position for the side to move, if the game is over
+ * @return Returns true if the game is over
+ */
+bool Search::isGameOver(const Position& position, int ply, int& score)
+{
+    // the game ends as soon as either side can't move (see GameState), so a side that
+    // has just left itself without moves has lost, and neither side moving is a stalemate
+    bool isWhite = position.isWhiteToMove();
+    bool canMove = position.hasMoves(isWhite);
+    bool opponentCanMove = position.hasMoves(!isWhite);
+    if (canMove && (opponentCanMove || ply == 0))
+        return false;
+
+    score = !canMove && !opponentCanMove ? 0 : !canMove ? -WIN_SCORE + ply : WIN_SCORE - ply;
+    return true;
+}
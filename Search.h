@@ -0,0 +1,264 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "Typedefs.h"
+#include "Position.h"
+#include "Move.h"
+#include "Arena.h"
+#include "MovePicker.h"
+#include "SearchStats.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <chrono>
+#include <functional>
+
+class TranspositionTable;
+class Tablebase;
+
+/**
+ * The limits placed on a single search (a limit of zero means no limit).
+ *
+ * A clock (the time left, and what is added after each move) is budgeted into a soft limit, after which
+ * no new iteration is started, and a hard limit, at which the iteration under way is abandoned
+ * (see Search::getTimeLimits). A movetime is both at once.
+ */
+struct SearchLimits
+{
+	int depth = 8;        // the deepest iteration to search, in plies
+	long long nodes = 0;  // the number of positions to visit before stopping
+	int movetime = 0;     // the number of milliseconds to search for
+	int time = 0;         // the milliseconds left on the clock of the side to move
+	int increment = 0;    // the milliseconds added to that clock after each move
+	int movesToGo = 0;    // the moves left until the clock is next topped up (0 if it never is)
+};
+
+/**
+ * The outcome of a search: the move to play and what the search expects to happen after it.
+ */
+struct SearchResult
+{
+	Move bestMove = Move(); // the null move if the side to move had no moves
+	int score = 0;          // from the point of view of the side to move
+	int depth = 0;          // the deepest iteration that was completed (0 if it was stopped before any)
+	long long nodes = 0;    // the number of positions visited
+	std::vector<Move> pv;   // the principal variation, starting with bestMove
+	SearchStats stats;      // what the search did (only filled in once it is over)
+};
+
+/**
+ * A negamax alpha-beta search with iterative deepening, which finds the best move
+ * for the side to move in a Position.
+ *
+ * Positions with few enough pieces are looked up in the endgame tables (if there are any) instead of searched.
+ * Moves are tried in the order a MovePicker hands them out, which it learns from the cutoffs found so far.
+ * At the end of each line, a quiescence search plays out the jumps (which are forced) before the position
+ * is evaluated, so an exchange isn't cut off halfway through.
+ *
+ * A search can also ponder: run on the position expected after the opponent's reply while they are still
+ * deciding on it, with no limits at all until the reply is known to be the expected one, when it is given
+ * the limits for that move.
+ *
+ * The search can use several threads ("Lazy SMP"): every thread searches the same root on its own
+ * copy of the position, with helpers staggered a ply deeper than each other, and they share
+ * their work only through the transposition table.
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+class Search
+{
+	public:
+		// the score of a won game (the number of plies it takes to win is taken off, so faster wins score higher)
+		const static int WIN_SCORE = 30000;
+
+		// the deepest any iteration can go, in plies
+		const static int MAX_DEPTH = 64;
+
+		/**
+		 * Responsible for setting up a search.
+		 * @param table The transposition table to remember positions in (which may be shared between
+		 * searches, so later moves can use what earlier ones learned)
+		 * @param threads The number of threads to search with
+		 * @param tablebase The endgame tables to look positions up in (null to not use any)
+		 */
+		Search(TranspositionTable& table, int threads = 1, const Tablebase* tablebase = nullptr) :
+			table(table), threads(threads < 1 ? 1 : threads), tablebase(tablebase), stopped(false), stopRequested(false),
+			pondering(false), ponderHitTime(0), completedDepth(0), hitLimitsGiven(false) {};
+
+		/**
+		 * Encodes a move compactly (for the transposition table) by its starting and ending squares.
+		 * @param move The move to encode
+		 * @return Returns the encoded move, which is never 0
+		 */
+		static uint16_t encodeMove(const Move& move);
+
+		/**
+		 * Works out how long a search with the given limits may take, from its movetime and clock.
+		 * @param limits The limits
+		 * @param soft Set to the milliseconds after which no new iteration is started (0 if it isn't timed)
+		 * @param hard Set to the milliseconds after which the search stops, even partway through an iteration
+		 * (0 if it isn't timed)
+		 */
+		static void getTimeLimits(const SearchLimits& limits, int& soft, int& hard);
+
+		/**
+		 * Searches the given position one ply deeper at a time, until the depth, node or time limit is reached.
+		 * The first iteration is always finished (it takes next to no time), so there is always a move to play.
+		 * @param position The position to search, which decides whose move it is
+		 * @param limits The limits to stop searching at
+		 * @return Returns the result of the deepest completed iteration (or, if it was stopped before
+		 * completing any, just the first of the moves)
+		 */
+		SearchResult run(const Position& position, const SearchLimits& limits);
+
+		/**
+		 * Stops the search that is running (from another thread), as soon as every thread notices.
+		 * The search returns its last completed iteration. If it hasn't started yet, it stops as soon as it does.
+		 */
+		void stop();
+
+		/**
+		 * Sets whether the search ponders, which must be done before it runs: while it does, it ignores
+		 * the limits it is run with, and searches until it is stopped or ponderHit is called.
+		 * @param pondering Whether to ponder
+		 */
+		void setPondering(bool pondering) { this->pondering = pondering; }
+
+		/**
+		 * Tells a pondering search (from another thread) that the opponent played the move it expected,
+		 * so it carries on as a normal search with the given limits, its time counting from now.
+		 * If it has already gone as deep or visited as many positions as they allow, it stops at once.
+		 * @param limits The limits for the move (which may have changed since the search started)
+		 */
+		void ponderHit(const SearchLimits& limits);
+
+		/**
+		 * Sets a function to be told about each iteration the main thread completes (on that thread),
+		 * such as to report the search's progress as it goes.
+		 * @param onIteration The function, which is given the iteration's result so far (with the nodes visited
+		 * by every thread up to then, roughly)
+		 */
+		void setIterationCallback(const std::function<void(const SearchResult&)>& onIteration)
+		{ this->onIteration = onIteration; }
+
+	private:
+		// what each searching thread keeps to itself
+		struct Worker
+		{
+			int id;               // 0 for the main thread, which decides when the search ends
+			SearchStats stats;    // what this thread did (including the positions it visited)
+			long long unreported; // positions not yet added to the shared count
+			SearchResult result;  // this thread's deepest completed iteration
+			Arena arena;          // scratch space for each node's moves and lines, released as it returns
+
+			// what the thread has learned about which quiet moves cause cutoffs (see MovePicker)
+			Move killers[MAX_DEPTH + 1][MovePicker::KILLERS];
+			MovePicker::history_t history;
+		};
+
+		// a line of moves, kept in a fixed array so building it in the search never allocates
+		struct Line
+		{
+			int length;
+			Move moves[MAX_DEPTH];
+		};
+
+		TranspositionTable& table;
+		const int threads;
+		const Tablebase* tablebase;
+		std::atomic<bool> stopped;
+		std::atomic<bool> stopRequested;
+		std::atomic<long long> sharedNodes;
+		std::atomic<long long> maxNodes;
+		std::atomic<bool> timeLimited;               // whether the time limits are being enforced yet
+		std::atomic<bool> pondering;                 // whether the limits are waiting for ponderHit
+		std::atomic<long long> ponderHitTime;        // when ponderHit was called (in steady_clock ticks), or 0
+		std::chrono::steady_clock::time_point start; // when the search started
+		std::atomic<int> depthLimit;                 // the deepest iteration the main thread may search (0 if any)
+		std::atomic<long long> nodeLimit;            // the positions the search may visit (0 if any number)
+		std::atomic<bool> timed;                     // whether the search has a movetime or clock
+		std::atomic<int> softLimit;                  // milliseconds until no new iteration may start, if it is timed
+		std::atomic<int> hardLimit;                  // milliseconds until the search must stop, if it is timed
+		std::atomic<int> completedDepth;             // the main thread's deepest completed iteration
+		std::mutex limitsLock;                       // guards setting the limits, from run or ponderHit
+		SearchLimits hitLimits;                      // the limits given by a ponderHit before the search ran
+		bool hitLimitsGiven;
+		std::function<void(const SearchResult&)> onIteration;
+
+		/**
+		 * Sets the limits the search stops at (which must be done holding limitsLock).
+		 * @param limits The limits
+		 */
+		void setLimits(const SearchLimits& limits);
+
+		/**
+		 * Runs the iterative deepening loop of a single thread, until it finishes or the search is stopped.
+		 * @param worker The thread's own state, which receives its result
+		 * @param position The position to search
+		 */
+		void iterate(Worker& worker, const Position& position);
+
+		/**
+		 * Remembers a quiet move that caused a cutoff, so it is tried sooner elsewhere.
+		 * @param worker The thread that searched it
+		 * @param position The position the move was made in
+		 * @param move The move
+		 * @param depth The depth it was searched to
+		 * @param ply The number of plies from the root
+		 */
+		void rememberCutoff(Worker& worker, const Position& position, const Move& move, int depth, int ply);
+
+		/**
+		 * @return Returns true if the given time has passed since the search started (or since the ponder hit,
+		 * if it pondered), and never while it is still pondering
+		 * @param milliseconds The time
+		 */
+		bool isPast(int milliseconds) const;
+
+		/**
+		 * Counts a visited position, stopping the search if the node limit or hard deadline has been reached.
+		 * @param worker The thread that visited it
+		 */
+		void countNode(Worker& worker);
+
+		/**
+		 * Searches the given position to the given depth, within the window of alpha and beta.
+		 * @param worker The thread doing the searching
+		 * @param position The position to search (moves are made and unmade on it, so it is unchanged afterwards)
+		 * @param depth The number of plies left to search
+		 * @param ply The number of plies from the root
+		 * @param alpha The score the side to move is already guaranteed
+		 * @param beta The score the opponent is already guaranteed (so anything above it is a cutoff)
+		 * @param pv Filled with the best line found from this position
+		 * (which may stop short where the transposition table cut the search off)
+		 * @return Returns the score of the position for the side to move
+		 */
+		int negamax(Worker& worker, Position& position, int depth, int ply, int alpha, int beta, Line& pv);
+
+		/**
+		 * Searches only the jumps of the given position (and of the positions they lead to), within the window
+		 * of alpha and beta. A side that can jump has to, so only a side without jumps can stop and take the evaluation.
+		 * @param worker The thread doing the searching
+		 * @param position The position to search, in which the game isn't over
+		 * (moves are made and unmade on it, so it is unchanged afterwards)
+		 * @param ply The number of plies from the root
+		 * @param alpha The score the side to move is already guaranteed
+		 * @param beta The score the opponent is already guaranteed (so anything above it is a cutoff)
+		 * @return Returns the score of the position for the side to move
+		 */
+		int quiesce(Worker& worker, Position& position, int ply, int alpha, int beta);
+
+		/**
+		 * Checks whether the game is over in the given position (because either side can't move, though at
+		 * the root only the side to move running out of moves counts, since a move is still needed).
+		 * @param position The position
+		 * @param ply The number of plies from the root
+		 * @param score Set to the score of the position for the side to move, if the game is over
+		 * @return Returns true if the game is over
+		 */
+		static bool isGameOver(const Position& position, int ply, int& score);
+};
+
+#endif
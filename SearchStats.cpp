@@ -0,0 +1,73 @@
+#include "SearchStats.h"
+
+#include "MovePicker.h"
+
+#include <sstream>
+#include <iomanip>
+
+/**
+ * Adds another thread's counts to these (leaving the times alone).
+ * @param other The other counts
+ */
+void SearchStats::add(const SearchStats& other)
+{
+    nodes += other.nodes;
+    quiescenceNodes += other.quiescenceNodes;
+    evaluations += other.evaluations;
+    moveGenerations += other.moveGenerations;
+    tableProbes += other.tableProbes;
+    tableHits += other.tableHits;
+    tableCutoffs += other.tableCutoffs;
+    tableCollisions += other.tableCollisions;
+    cutoffs += other.cutoffs;
+
+    for (int i = 0; i < CUTOFF_INDEXES; i++)
+        cutoffsByIndex[i] += other.cutoffsByIndex[i];
+    for (int i = 0; i < MovePicker::DONE; i++)
+        cutoffsByStage[i] += other.cutoffsByStage[i];
+}
+
+/**
+ * Writes a list of numbers as a JSON array.
+ */
+template <typename T>
+static void writeArray(std::ostream& out, const T* values, size_t count)
+{
+    out << '[';
+    for (size_t i = 0; i < count; i++)
+        out << (i > 0 ? "," : "") << values[i];
+    out << ']';
+}
+
+/**
+ * @return Returns the statistics as a single line of JSON
+ */
+std::string SearchStats::toJson() const
+{
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(3);
+
+    json << "{\"nodes\":" << nodes << ",\"quiescenceNodes\":" << quiescenceNodes << ",\"nps\":" << getNodesPerSecond()
+         << ",\"evaluations\":" << evaluations << ",\"moveGenerations\":" << moveGenerations;
+
+    json << ",\"table\":{\"probes\":" << tableProbes << ",\"hits\":" << tableHits << ",\"cutoffs\":" << tableCutoffs
+         << ",\"collisions\":" << tableCollisions
+         << ",\"hitRate\":" << (tableProbes > 0 ? (double)tableHits / tableProbes : 0.0) << '}';
+
+    // (the stages in the order MovePicker hands them out)
+    json << ",\"cutoffs\":{\"total\":" << cutoffs << ",\"byIndex\":";
+    writeArray(json, cutoffsByIndex, CUTOFF_INDEXES);
+    json << ",\"byStage\":{\"table\":" << cutoffsByStage[MovePicker::TABLE_MOVE]
+         << ",\"captures\":" << cutoffsByStage[MovePicker::CAPTURES]
+         << ",\"killers\":" << cutoffsByStage[MovePicker::KILLER_MOVES]
+         << ",\"quiet\":" << cutoffsByStage[MovePicker::QUIET_MOVES] << "}}";
+
+    json << ",\"milliseconds\":" << milliseconds << ",\"phases\":{\"setup\":" << setupMilliseconds << ",\"iterations\":";
+    writeArray(json, iterationMilliseconds.data(), iterationMilliseconds.size());
+    json << ",\"finish\":" << finishMilliseconds << '}';
+
+    json << ",\"threadNodes\":";
+    writeArray(json, threadNodes.data(), threadNodes.size());
+    json << '}';
+    return json.str();
+}
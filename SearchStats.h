@@ -0,0 +1,61 @@
+#ifndef SEARCH_STATS_H
+#define SEARCH_STATS_H
+
+#include "MovePicker.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * What a search did and how fast: the positions it visited, how well the transposition table and
+ * move ordering worked, and where its time went.
+ *
+ * Every searching thread counts into its own copy, with plain increments, and the copies are only added
+ * together once the search is over, so counting costs next to nothing.
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+struct SearchStats
+{
+	// the number of move indexes cutoffs are counted by (the last counting every later move too)
+	const static int CUTOFF_INDEXES = 8;
+
+	long long nodes = 0;            // positions visited, including those of the quiescence search
+	long long quiescenceNodes = 0;  // positions visited by the quiescence search
+	long long evaluations = 0;      // static evaluations
+	long long moveGenerations = 0;  // times the moves (or only the jumps) of a position were generated
+	long long tableProbes = 0;      // transposition table lookups
+	long long tableHits = 0;        // lookups that found the position
+	long long tableCutoffs = 0;     // hits deep enough to end the search of the position at once
+	long long tableCollisions = 0;  // hits whose best move isn't a move of the position (another position's entry)
+	long long cutoffs = 0;          // positions whose search was cut off by a move scoring at least beta
+
+	// the cutoffs by which move caused them (0 for the first tried), and by the MovePicker::Stage it was picked in
+	long long cutoffsByIndex[CUTOFF_INDEXES] = {};
+	long long cutoffsByStage[MovePicker::DONE] = {};
+
+	double milliseconds = 0;                   // the whole search
+	double setupMilliseconds = 0;              // getting the threads ready
+	std::vector<double> iterationMilliseconds; // each iteration of the main thread, from depth 1 (the last may be partial)
+	double finishMilliseconds = 0;             // stopping the helper threads once the main thread was done
+	std::vector<long long> threadNodes;        // the positions each thread visited, the main thread first
+
+	/**
+	 * Adds another thread's counts to these (leaving the times alone).
+	 * @param other The other counts
+	 */
+	void add(const SearchStats& other);
+
+	/**
+	 * @return Returns the positions visited per second
+	 */
+	long long getNodesPerSecond() const { return milliseconds > 0 ? (long long)(nodes * 1000 / milliseconds) : nodes; }
+
+	/**
+	 * @return Returns the statistics as a single line of JSON
+	 */
+	std::string toJson() const;
+};
+
+#endif
@@ -0,0 +1,420 @@
+#include "Tablebase.h"
+
+#include "Position.h"
+#include "MappedFile.h"
+#include "Typedefs.h"
+
+#include <fstream>
+#include <cstring>
+
+// men can't stand on the row they would be crowned on, so each side's men have 28 possible squares
+// (white's are squares 0-27, and black's are squares 4-31)
+static const int MEN_SQUARES = 28;
+static const int BLACK_MEN_OFFSET = 4;
+
+// what goes at the start of every file, to recognise it and check it matches its name
+static const char MAGIC[4] = { 'C', 'K', 'T', 'B' };
+static const uint32_t VERSION = 2; // (2 since jumps became forced, which changed the values of positions)
+static const size_t HEADER_SIZE = 24;
+
+// a block is stored raw (a byte per position) when that is smaller than run-length encoding it
+static const uint32_t RAW_BLOCK = 0x80000000u;
+
+// Pascal's triangle, big enough for any number of squares and pieces (filled in before main runs)
+static struct Binomials
+{
+    uint64_t values[Position::SQUARES + 1][Position::SQUARES + 1];
+
+    Binomials()
+    {
+        for (int n = 0; n <= Position::SQUARES; n++)
+        {
+            values[n][0] = 1;
+            for (int k = 1; k <= Position::SQUARES; k++)
+                values[n][k] = k > n ? 0 : values[n - 1][k - 1] + (k < n ? values[n - 1][k] : 0);
+        }
+    }
+} BINOMIALS;
+
+/**
+ * @return Returns the number of ways to choose k things from n
+ */
+static uint64_t binomial(int n, int k)
+{
+    return k < 0 || n < 0 || k > n ? 0 : BINOMIALS.values[n][k];
+}
+
+/**
+ * @return Returns the rank of a set of places among all sets of the same size
+ * (the "colexicographic" rank: the sum of choose(place, i) for the i-th lowest place)
+ * @param places A bitboard of the places (not necessarily squares) to rank
+ */
+static uint64_t rankPlaces(bitboard_t places)
+{
+    uint64_t rank = 0;
+    for (int i = 1; places; i++)
+        rank += binomial(Position::popSquare(places), i);
+    return rank;
+}
+
+/**
+ * @return Returns the set of places with the given rank (the opposite of rankPlaces)
+ * @param rank The rank of the set
+ * @param count The number of places in the set
+ */
+static bitboard_t unrankPlaces(uint64_t rank, int count)
+{
+    bitboard_t places = 0;
+    for (int i = count; i >= 1; i--)
+    {
+        // the highest place is the largest one whose binomial still fits in the rank
+        int place = i - 1;
+        while (binomial(place + 1, i) <= rank)
+            place++;
+
+        rank -= binomial(place, i);
+        places |= 1u << place;
+    }
+    return places;
+}
+
+/**
+ * @return Returns the squares not occupied, numbered from zero, that the given squares are on
+ * (so kings can be ranked among only the squares the men left free)
+ * @param squares The squares to renumber (none of which are occupied)
+ * @param occupied The squares to skip over
+ */
+static bitboard_t compressSquares(bitboard_t squares, bitboard_t occupied)
+{
+    bitboard_t places = 0;
+    while (squares)
+    {
+        int square = Position::popSquare(squares);
+        places |= 1u << (square - Position::countSquares(occupied & ((1u << square) - 1)));
+    }
+    return places;
+}
+
+/**
+ * @return Returns the squares the given free-square places are on (the opposite of compressSquares)
+ * @param places The places, counting only unoccupied squares
+ * @param occupied The squares that were skipped over
+ */
+static bitboard_t expandSquares(bitboard_t places, bitboard_t occupied)
+{
+    bitboard_t squares = 0;
+    int place = 0;
+    for (int square = 0; square < Position::SQUARES && places; square++)
+    {
+        if (occupied & (1u << square))
+            continue;
+
+        if (places & (1u << place))
+        {
+            squares |= 1u << square;
+            places &= ~(1u << place);
+        }
+        place++;
+    }
+    return squares;
+}
+
+/**
+ * Responsible for setting up probing of the tables in a directory.
+ * (Nothing is read until a position is probed)
+ * @param directory The directory the tables were generated in
+ */
+Tablebase::Tablebase(const std::string& directory) : directory(directory)
+{
+    for (int i = 0; i < TABLES; i++)
+        states[i].store(UNTRIED, std::memory_order_relaxed);
+}
+
+/**
+ * @return Returns the number of each kind of piece in a position
+ */
+Material Tablebase::getMaterial(const Position& position)
+{
+    bitboard_t kings = position.getKings();
+
+    Material material;
+    material.whiteMen = Position::countSquares(position.getPieces(true) & ~kings);
+    material.whiteKings = Position::countSquares(position.getPieces(true) & kings);
+    material.blackMen = Position::countSquares(position.getPieces(false) & ~kings);
+    material.blackKings = Position::countSquares(position.getPieces(false) & kings);
+    return material;
+}
+
+/**
+ * @return Returns true if a table can be made for the given material
+ * (both sides have pieces, and there aren't too many in total)
+ */
+bool Tablebase::isIndexable(const Material& material)
+{
+    return material.whiteMen >= 0 && material.whiteKings >= 0 && material.blackMen >= 0 && material.blackKings >= 0 &&
+           material.whiteMen + material.whiteKings > 0 && material.blackMen + material.blackKings > 0 &&
+           material.getTotal() <= MAX_PIECES;
+}
+
+/**
+ * @return Returns the number of slots in the table for the given material
+ * (including some for impossible placements, such as men of both sides on the same square)
+ */
+uint64_t Tablebase::getSize(const Material& material)
+{
+    int free = Position::SQUARES - material.whiteMen - material.blackMen;
+    return binomial(MEN_SQUARES, material.whiteMen) * binomial(MEN_SQUARES, material.blackMen) *
+           binomial(free, material.whiteKings) * binomial(free - material.whiteKings, material.blackKings) * 2;
+}
+
+/**
+ * @return Returns the index of a position in the table for its material
+ */
+uint64_t Tablebase::getIndex(const Position& position)
+{
+    Material material = getMaterial(position);
+    bitboard_t kings = position.getKings();
+    bitboard_t whiteMen = position.getPieces(true) & ~kings;
+    bitboard_t blackMen = position.getPieces(false) & ~kings;
+    bitboard_t whiteKings = position.getPieces(true) & kings;
+    bitboard_t blackKings = position.getPieces(false) & kings;
+
+    // each side's men are ranked among the squares men can be on, then the kings among the squares left
+    int free = Position::SQUARES - material.whiteMen - material.blackMen;
+    uint64_t index = rankPlaces(whiteMen);
+    index = index * binomial(MEN_SQUARES, material.blackMen) + rankPlaces(blackMen >> BLACK_MEN_OFFSET);
+    index = index * binomial(free, material.whiteKings) + rankPlaces(compressSquares(whiteKings, whiteMen | blackMen));
+    index = index * binomial(free - material.whiteKings, material.blackKings) +
+            rankPlaces(compressSquares(blackKings, whiteMen | blackMen | whiteKings));
+
+    return index * 2 + (position.isWhiteToMove() ? 0 : 1);
+}
+
+/**
+ * Sets up the position with the given index in a table (the opposite of getIndex).
+ * @param material The material of the table
+ * @param index The index of the position
+ * @param position Set to the position
+ * @return Returns false if no position has this index
+ */
+bool Tablebase::setPosition(const Material& material, uint64_t index, Position& position)
+{
+    int free = Position::SQUARES - material.whiteMen - material.blackMen;
+    uint64_t blackKingCount = binomial(free - material.whiteKings, material.blackKings);
+    uint64_t whiteKingCount = binomial(free, material.whiteKings);
+    uint64_t blackMenCount = binomial(MEN_SQUARES, material.blackMen);
+
+    bool whiteToMove = index % 2 == 0;
+    index /= 2;
+    uint64_t blackKingRank = index % blackKingCount;
+    index /= blackKingCount;
+    uint64_t whiteKingRank = index % whiteKingCount;
+    index /= whiteKingCount;
+    uint64_t blackMenRank = index % blackMenCount;
+    uint64_t whiteMenRank = index / blackMenCount;
+
+    bitboard_t whiteMen = unrankPlaces(whiteMenRank, material.whiteMen);
+    bitboard_t blackMen = unrankPlaces(blackMenRank, material.blackMen) << BLACK_MEN_OFFSET;
+    if (whiteMen & blackMen)
+        return false;
+
+    bitboard_t whiteKings = expandSquares(unrankPlaces(whiteKingRank, material.whiteKings), whiteMen | blackMen);
+    bitboard_t blackKings = expandSquares(unrankPlaces(blackKingRank, material.blackKings), whiteMen | blackMen | whiteKings);
+
+    position = Position();
+    while (whiteMen)
+        position.setPiece(Position::popSquare(whiteMen), true, false);
+    while (blackMen)
+        position.setPiece(Position::popSquare(blackMen), false, false);
+    while (whiteKings)
+        position.setPiece(Position::popSquare(whiteKings), true, true);
+    while (blackKings)
+        position.setPiece(Position::popSquare(blackKings), false, true);
+    position.setWhiteToMove(whiteToMove);
+    return true;
+}
+
+/**
+ * @return Returns the number of the table for the given material
+ */
+int Tablebase::getTableNumber(const Material& material)
+{
+    int base = MAX_PIECES + 1;
+    return ((material.whiteMen * base + material.whiteKings) * base + material.blackMen) * base + material.blackKings;
+}
+
+/**
+ * @return Returns the name of the file holding the table for the given material
+ */
+std::string Tablebase::getFileName(const Material& material)
+{
+    return "tb_" + std::to_string(material.whiteMen) + std::to_string(material.whiteKings) +
+           std::to_string(material.blackMen) + std::to_string(material.blackKings) + ".wld";
+}
+
+/**
+ * Writes a table to a file.
+ * The file is a header, then where each block starts (one more than the number of blocks, so
+ * the last says where the data ends), then the blocks. A block is either stored raw, a code
+ * to a byte, or as runs of the same code, two bytes each (the length of the run less one, then the code).
+ * @param path The path of the file to write
+ * @param material The material of the table
+ * @param values The code of every index (see encode), or NO_POSITION for an index with no position
+ * (which is stored as whatever compresses best)
+ * @return Returns the size of the file, or 0 if it couldn't be written
+ */
+size_t Tablebase::write(const std::string& path, const Material& material, const std::vector<uint8_t>& values)
+{
+    uint64_t size = values.size();
+    uint32_t blocks = (uint32_t)((size + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+    std::vector<uint32_t> offsets;
+    std::vector<uint8_t> data;
+    uint8_t previous = 0;
+
+    for (uint32_t block = 0; block < blocks; block++)
+    {
+        uint64_t start = (uint64_t)block * BLOCK_SIZE;
+        int length = (int)(start + BLOCK_SIZE < size ? BLOCK_SIZE : size - start);
+
+        // empty slots just continue whatever run they're in
+        uint8_t codes[BLOCK_SIZE];
+        for (int i = 0; i < length; i++)
+        {
+            if (values[start + i] != NO_POSITION)
+                previous = values[start + i];
+            codes[i] = previous;
+        }
+
+        std::vector<uint8_t> runs;
+        for (int i = 0; i < length; )
+        {
+            int run = 1;
+            while (i + run < length && codes[i + run] == codes[i])
+                run++;
+            runs.push_back((uint8_t)(run - 1));
+            runs.push_back(codes[i]);
+            i += run;
+        }
+
+        if (runs.size() < (size_t)length)
+        {
+            offsets.push_back((uint32_t)data.size());
+            data.insert(data.end(), runs.begin(), runs.end());
+        }
+        else
+        {
+            offsets.push_back((uint32_t)data.size() | RAW_BLOCK);
+            data.insert(data.end(), codes, codes + length);
+        }
+    }
+    offsets.push_back((uint32_t)data.size());
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return 0;
+
+    uint8_t counts[4] = { (uint8_t)material.whiteMen, (uint8_t)material.whiteKings,
+                          (uint8_t)material.blackMen, (uint8_t)material.blackKings };
+    file.write(MAGIC, sizeof(MAGIC));
+    file.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+    file.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+    file.write(reinterpret_cast<const char*>(&blocks), sizeof(blocks));
+    file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    file.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+
+    if (!file)
+        return 0;
+    return HEADER_SIZE + offsets.size() * sizeof(uint32_t) + data.size();
+}
+
+/**
+ * Maps the file of a table into memory, if it exists.
+ * @param material The material of the table
+ * @return Returns the table, or null if it has no file (or the file isn't a valid table)
+ */
+Tablebase::Table* Tablebase::load(const Material& material) const
+{
+    std::unique_ptr<Table> table(new Table());
+    if (!table->file.open(directory + "/" + getFileName(material)) || table->file.getSize() < HEADER_SIZE)
+        return nullptr;
+
+    // make sure the file is what its name says it is before trusting anything in it
+    const unsigned char* bytes = table->file.getData();
+    uint32_t version, blocks;
+    uint64_t size;
+    std::memcpy(&version, bytes + 4, sizeof(version));
+    std::memcpy(&blocks, bytes + 12, sizeof(blocks));
+    std::memcpy(&size, bytes + 16, sizeof(size));
+
+    if (std::memcmp(bytes, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION ||
+        bytes[8] != material.whiteMen || bytes[9] != material.whiteKings ||
+        bytes[10] != material.blackMen || bytes[11] != material.blackKings ||
+        size != getSize(material) || blocks != (size + BLOCK_SIZE - 1) / BLOCK_SIZE ||
+        table->file.getSize() < HEADER_SIZE + (blocks + 1) * sizeof(uint32_t))
+        return nullptr;
+
+    table->offsets = reinterpret_cast<const uint32_t*>(bytes + HEADER_SIZE);
+    table->data = bytes + HEADER_SIZE + (blocks + 1) * sizeof(uint32_t);
+    if (table->data + table->offsets[blocks] > bytes + table->file.getSize())
+        return nullptr;
+
+    return table.release();
+}
+
+/**
+ * Looks up the value of a position, loading its table the first time it is needed.
+ * Safe to call from several threads at once.
+ * @param position The position to look up
+ * @param distance Set to the number of plies until the game is won or lost, if it isn't a draw
+ * (may be null)
+ * @return Returns the Value of the position for the side to move
+ */
+int Tablebase::probe(const Position& position, int* distance) const
+{
+    Material material = getMaterial(position);
+    if (!isIndexable(material))
+        return UNKNOWN;
+
+    // only the first probe of a table has to take the lock (to map its file)
+    int number = getTableNumber(material);
+    int state = states[number].load(std::memory_order_acquire);
+    if (state == UNTRIED)
+    {
+        std::lock_guard<std::mutex> lock(loading);
+        state = states[number].load(std::memory_order_relaxed);
+        if (state == UNTRIED)
+        {
+            tables[number].reset(load(material));
+            state = tables[number] != nullptr ? LOADED : MISSING;
+            states[number].store(state, std::memory_order_release);
+        }
+    }
+    if (state == MISSING)
+        return UNKNOWN;
+
+    const Table& table = *tables[number];
+    uint64_t index = getIndex(position);
+    uint32_t offset = table.offsets[index / BLOCK_SIZE];
+    int place = index % BLOCK_SIZE;
+
+    uint8_t code;
+    if (offset & RAW_BLOCK)
+        code = table.data[(offset & ~RAW_BLOCK) + place];
+    else
+    {
+        // walk the runs until we reach the one our position is in
+        const uint8_t* run = table.data + offset;
+        while (place > run[0])
+        {
+            place -= run[0] + 1;
+            run += 2;
+        }
+        code = run[1];
+    }
+
+    if (distance != nullptr)
+        *distance = getDistance(code);
+    return getValue(code);
+}
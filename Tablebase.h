@@ -0,0 +1,176 @@
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+#include "MappedFile.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+
+class Position;
+
+/**
+ * The number of each kind of piece on the board, which decides which table a position is in.
+ */
+struct Material
+{
+	int whiteMen;
+	int whiteKings;
+	int blackMen;
+	int blackKings;
+
+	int getTotal() const { return whiteMen + whiteKings + blackMen + blackKings; }
+};
+
+/**
+ * Endgame databases: whether every position with only a few pieces left is a win, loss or draw
+ * for the side to move, and how many plies it takes to win it with best play from both sides,
+ * worked out ahead of time by the tbgen tool.
+ *
+ * There is one table (and one file) for each combination of numbers of men and kings. Inside it,
+ * a position's index is worked out from where its pieces are (each kind of piece is ranked as a
+ * combination of the squares it could be on), so every position has its own slot without storing
+ * any keys. Each position's value is a byte (see encode), run-length encoded in small blocks, and
+ * the files are memory-mapped, so a table is only read from disk once it is actually probed.
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+class Tablebase
+{
+	public:
+		// what a position is worth to the side to move (UNKNOWN if there is no table for it)
+		enum Value { DRAW = 0, WIN = 1, LOSS = 2, UNKNOWN = 3 };
+
+		// the most pieces a table can be made for
+		const static int MAX_PIECES = 8;
+
+		// the longest distance to the end of the game that is stored (longer ones are stored as this)
+		const static int MAX_DISTANCE = 125;
+
+		// the number of positions in each block of a file (see write)
+		const static int BLOCK_SIZE = 256;
+
+		// the code given to an index with no position in it
+		const static uint8_t NO_POSITION = 255;
+
+		/**
+		 * Responsible for setting up probing of the tables in a directory.
+		 * (Nothing is read until a position is probed)
+		 * @param directory The directory the tables were generated in
+		 */
+		Tablebase(const std::string& directory);
+
+		/**
+		 * Looks up the value of a position, loading its table the first time it is needed.
+		 * Safe to call from several threads at once.
+		 * @param position The position to look up
+		 * @param distance Set to the number of plies until the game is won or lost, if it isn't a draw
+		 * (may be null)
+		 * @return Returns the Value of the position for the side to move
+		 */
+		int probe(const Position& position, int* distance = nullptr) const;
+
+		/**
+		 * Packs a value and distance into the byte stored for a position: 0 for a draw, or the distance
+		 * doubled, plus one for a win or two for a loss.
+		 * @param value The Value of the position (DRAW, WIN or LOSS)
+		 * @param distance The number of plies until the game is won or lost
+		 * @return Returns the code
+		 */
+		static uint8_t encode(int value, int distance)
+		{ return value == DRAW ? 0 : (uint8_t)(2 * (distance < MAX_DISTANCE ? distance : MAX_DISTANCE) + value); }
+
+		/**
+		 * @return Returns the Value a code stands for (see encode)
+		 */
+		static int getValue(uint8_t code) { return code == 0 ? DRAW : 2 - code % 2; }
+
+		/**
+		 * @return Returns the distance a code stands for (see encode)
+		 */
+		static int getDistance(uint8_t code) { return code == 0 ? 0 : (code - 1) / 2; }
+
+		/**
+		 * @return Returns the number of each kind of piece in a position
+		 */
+		static Material getMaterial(const Position& position);
+
+		/**
+		 * @return Returns true if a table can be made for the given material
+		 * (both sides have pieces, and there aren't too many in total)
+		 */
+		static bool isIndexable(const Material& material);
+
+		/**
+		 * @return Returns the number of slots in the table for the given material
+		 * (including some for impossible placements, such as men of both sides on the same square)
+		 */
+		static uint64_t getSize(const Material& material);
+
+		/**
+		 * @return Returns the index of a position in the table for its material
+		 */
+		static uint64_t getIndex(const Position& position);
+
+		/**
+		 * Sets up the position with the given index in a table (the opposite of getIndex).
+		 * @param material The material of the table
+		 * @param index The index of the position
+		 * @param position Set to the position
+		 * @return Returns false if no position has this index
+		 */
+		static bool setPosition(const Material& material, uint64_t index, Position& position);
+
+		/**
+		 * @return Returns the name of the file holding the table for the given material
+		 */
+		static std::string getFileName(const Material& material);
+
+		/**
+		 * Writes a table to a file.
+		 * @param path The path of the file to write
+		 * @param material The material of the table
+		 * @param values The code of every index (see encode), or NO_POSITION for an index with no position
+		 * (which is stored as whatever compresses best)
+		 * @return Returns the size of the file, or 0 if it couldn't be written
+		 */
+		static size_t write(const std::string& path, const Material& material, const std::vector<uint8_t>& values);
+
+	private:
+		// one table, once its file has been mapped
+		struct Table
+		{
+			MappedFile file;
+			const uint32_t* offsets; // where each block starts in the data (the top bit is set if it is stored raw)
+			const uint8_t* data;
+		};
+
+		// every combination of piece counts that fits in MAX_PIECES, numbered by getTableNumber
+		const static int TABLES = (MAX_PIECES + 1) * (MAX_PIECES + 1) * (MAX_PIECES + 1) * (MAX_PIECES + 1);
+
+		// whether each table is still to be loaded, was loaded or is missing
+		enum State { UNTRIED = 0, LOADED = 1, MISSING = 2 };
+
+		const std::string directory;
+		mutable std::mutex loading;
+		mutable std::atomic<int> states[TABLES];
+		mutable std::unique_ptr<Table> tables[TABLES];
+
+		/**
+		 * @return Returns the number of the table for the given material
+		 */
+		static int getTableNumber(const Material& material);
+
+		/**
+		 * Maps the file of a table into memory, if it exists.
+		 * @param material The material of the table
+		 * @return Returns the table, or null if it has no file (or the file isn't a valid table)
+		 */
+		Table* load(const Material& material) const;
+};
+
+#endif
@@ -0,0 +1,165 @@
+#include "TranspositionTable.h"
+
+#include <cstdint>
+#include <new>
+
+// the size of a cache line, which buckets are aligned to
+static const size_t CACHE_LINE = 64;
+
+/**
+ * Responsible for allocating the table.
+ * @param megabytes The amount of memory the table may use
+ * (rounded down to a power of two number of buckets)
+ */
+TranspositionTable::TranspositionTable(size_t megabytes) : buckets(nullptr), bucketCount(0), age(0)
+{
+    resize(megabytes);
+}
+
+/**
+ * Reallocates the table to a new size, forgetting everything in it.
+ * (Must not be called while a search is using the table)
+ * @param megabytes The amount of memory the table may use
+ */
+void TranspositionTable::resize(size_t megabytes)
+{
+    static_assert(sizeof(Bucket) == CACHE_LINE, "a bucket should fill exactly one cache line");
+
+    // use the largest power of two number of buckets that fits (so a key can be masked to an index),
+    // but always have at least one
+    size_t bytes = megabytes * 1024 * 1024;
+    bucketCount = 1;
+    while (bucketCount * 2 * sizeof(Bucket) <= bytes)
+        bucketCount *= 2;
+
+    memory.reset(new char[bucketCount * sizeof(Bucket) + CACHE_LINE]);
+    uintptr_t address = reinterpret_cast<uintptr_t>(memory.get());
+    buckets = reinterpret_cast<Bucket*>((address + CACHE_LINE - 1) & ~(uintptr_t)(CACHE_LINE - 1));
+
+    // the atomics have to be constructed in the raw memory (they're just words, so nothing to destroy)
+    for (size_t i = 0; i < bucketCount; i++)
+        new (&buckets[i]) Bucket();
+
+    clear();
+}
+
+/**
+ * Forgets every stored entry.
+ * (Must not be called while a search is using the table)
+ */
+void TranspositionTable::clear()
+{
+    for (size_t i = 0; i < bucketCount; i++)
+    {
+        for (int j = 0; j < ENTRIES_PER_BUCKET; j++)
+        {
+            buckets[i].slots[j].check.store(0, std::memory_order_relaxed);
+            buckets[i].slots[j].data.store(0, std::memory_order_relaxed);
+        }
+    }
+    age = 0;
+}
+
+/**
+ * @return Returns the entry packed into a single word
+ */
+uint64_t TranspositionTable::pack(const TTEntry& entry)
+{
+    return (uint64_t)entry.move
+         | (uint64_t)(uint16_t)entry.score << 16
+         | (uint64_t)(uint8_t)entry.depth << 32
+         | (uint64_t)entry.bound << 40
+         | (uint64_t)entry.age << 48;
+}
+
+/**
+ * @return Returns the entry unpacked from a single word
+ */
+TTEntry TranspositionTable::unpack(uint64_t data)
+{
+    TTEntry entry;
+    entry.move = (uint16_t)data;
+    entry.score = (int16_t)(uint16_t)(data >> 16);
+    entry.depth = (int8_t)(uint8_t)(data >> 32);
+    entry.bound = (uint8_t)(data >> 40);
+    entry.age = (uint8_t)(data >> 48);
+    return entry;
+}
+
+/**
+ * Looks up a position.
+ * @param key The Zobrist key of the position
+ * @param entry Filled with the stored entry if one is found
+ * @return Returns true if the position was found
+ */
+bool TranspositionTable::probe(uint64_t key, TTEntry& entry) const
+{
+    Bucket& bucket = getBucket(key);
+    for (int i = 0; i < ENTRIES_PER_BUCKET; i++)
+    {
+        uint64_t data = bucket.slots[i].data.load(std::memory_order_relaxed);
+        uint64_t check = bucket.slots[i].check.load(std::memory_order_relaxed);
+
+        // a slot another thread was halfway through writing won't match, so it's just skipped
+        if ((check ^ data) == key && data != 0)
+        {
+            entry = unpack(data);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Stores the result of searching a position.
+ * @param key The Zobrist key of the position
+ * @param depth The depth the position was searched to
+ * @param bound Whether the score is exact or a bound (see Bound)
+ * @param score The score found
+ * @param move The encoded best move (0 if none)
+ */
+void TranspositionTable::store(uint64_t key, int depth, int bound, int score, uint16_t move)
+{
+    Bucket& bucket = getBucket(key);
+    uint8_t currentAge = age.load(std::memory_order_relaxed);
+
+    // reuse this position's own slot if it has one, otherwise replace the entry that is
+    // worth least: the shallowest one, counting entries from earlier searches as shallower still
+    Slot* replace = &bucket.slots[0];
+    int replaceWorth = 1 << 30;
+    for (int i = 0; i < ENTRIES_PER_BUCKET; i++)
+    {
+        Slot& slot = bucket.slots[i];
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t check = slot.check.load(std::memory_order_relaxed);
+        TTEntry old = unpack(data);
+
+        if ((check ^ data) == key && data != 0)
+        {
+            replace = &slot;
+
+            // keep the old best move if we didn't find one this time
+            if (move == 0)
+                move = old.move;
+            break;
+        }
+
+        int worth = data == 0 ? -1 : old.depth - 8 * (uint8_t)(currentAge - old.age);
+        if (worth < replaceWorth)
+        {
+            replace = &slot;
+            replaceWorth = worth;
+        }
+    }
+
+    TTEntry entry;
+    entry.move = move;
+    entry.score = (int16_t)score;
+    entry.depth = (int8_t)depth;
+    entry.bound = (uint8_t)bound;
+    entry.age = currentAge;
+
+    uint64_t data = pack(entry);
+    replace->data.store(data, std::memory_order_relaxed);
+    replace->check.store(key ^ data, std::memory_order_relaxed);
+}
@@ -0,0 +1,123 @@
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <atomic>
+
+/**
+ * One remembered search result: what a position was worth, how deeply it was searched,
+ * and the best move found there.
+ */
+struct TTEntry
+{
+	uint16_t move;  // the best move, encoded by Search (0 if none)
+	int16_t score;
+	int8_t depth;
+	uint8_t bound;  // a TranspositionTable::Bound
+	uint8_t age;    // the search this was stored in, so old entries can be replaced first
+};
+
+/**
+ * A fixed-size hash table of search results, indexed by Zobrist key.
+ * Entries are grouped into buckets the size of a cache line, so a probe only ever touches
+ * one line of memory, and a new entry replaces the least useful one in its bucket.
+ *
+ * The table can be shared by several searching threads without any locks: each entry is two
+ * words, the data and the key XORed with the data, so an entry torn by two threads writing
+ * it at once no longer matches its key and is simply treated as missing.
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+class TranspositionTable
+{
+	public:
+		// what a stored score means: the exact value, or only a limit on it
+		enum Bound { NONE = 0, UPPER = 1, LOWER = 2, EXACT = 3 };
+
+		const static int ENTRIES_PER_BUCKET = 4;
+
+		/**
+		 * Responsible for allocating the table.
+		 * @param megabytes The amount of memory the table may use
+		 * (rounded down to a power of two number of buckets)
+		 */
+		TranspositionTable(size_t megabytes);
+
+		/**
+		 * Reallocates the table to a new size, forgetting everything in it.
+		 * (Must not be called while a search is using the table)
+		 * @param megabytes The amount of memory the table may use
+		 */
+		void resize(size_t megabytes);
+
+		/**
+		 * Forgets every stored entry.
+		 * (Must not be called while a search is using the table)
+		 */
+		void clear();
+
+		/**
+		 * Marks the start of a new search, so entries from earlier searches are replaced first.
+		 */
+		void newSearch() { age++; }
+
+		/**
+		 * Looks up a position.
+		 * @param key The Zobrist key of the position
+		 * @param entry Filled with the stored entry if one is found
+		 * @return Returns true if the position was found
+		 */
+		bool probe(uint64_t key, TTEntry& entry) const;
+
+		/**
+		 * Stores the result of searching a position.
+		 * @param key The Zobrist key of the position
+		 * @param depth The depth the position was searched to
+		 * @param bound Whether the score is exact or a bound (see Bound)
+		 * @param score The score found
+		 * @param move The encoded best move (0 if none)
+		 */
+		void store(uint64_t key, int depth, int bound, int score, uint16_t move);
+
+		/**
+		 * @return Returns the number of bytes the table uses
+		 */
+		size_t getSize() const { return bucketCount * sizeof(Bucket); }
+
+	private:
+		struct Slot
+		{
+			std::atomic<uint64_t> check; // the key XORed with the data
+			std::atomic<uint64_t> data;  // a TTEntry packed into one word
+		};
+
+		struct Bucket
+		{
+			Slot slots[ENTRIES_PER_BUCKET];
+		};
+
+		std::unique_ptr<char[]> memory; // over-allocated so the buckets can start on a cache line
+		Bucket* buckets;
+		size_t bucketCount;
+		std::atomic<uint8_t> age;
+
+		/**
+		 * @return Returns the bucket the given key belongs in
+		 */
+		Bucket& getBucket(uint64_t key) const { return buckets[key & (bucketCount - 1)]; }
+
+		/**
+		 * @return Returns the entry packed into a single word
+		 */
+		static uint64_t pack(const TTEntry& entry);
+
+		/**
+		 * @return Returns the entry unpacked from a single word
+		 */
+		static TTEntry unpack(uint64_t data);
+};
+
+#endif
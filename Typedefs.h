@@ -4,8 +4,7 @@
 #include <vector>
 #include <array>
 #include <memory>
-
-class Move;
+#include <cstdint>
 
 // There are several functions which use two-part arrays to talk 
 // about coordinates, so this is defined to make that simpler 
@@ -14,13 +13,12 @@ class Move;
 // they just decay to pointers.
 typedef std::array<int, 2> coords_t;
 
-// We use shared pointers with the Move arrays and with basic Moves
-// because these are "thrown around a lot" between functions,
-// so it is nice to not have to keep track of deleting the memory, 
-// but we can still use them as pointers and not worry about them being
-// copied (this is also important because the hash tables used
-// in AIPlayer.cpp basically need moves to be represented as pointers.)
-typedef std::vector<std::shared_ptr<Move>> moves_t;
-typedef std::shared_ptr<Move> move_ptr_t;
+// Moves used to be shared pointers, but they are small enough to just be
+// copied around, and lists of them are kept on the stack so that generating
+// moves never allocates memory (see Move.h and MoveList.h, which defines moves_t).
+
+// A set of squares, one bit for each of the 32 checkerboard spaces
+// (see Position.h for how the squares are numbered)
+typedef uint32_t bitboard_t;
 
 #endif
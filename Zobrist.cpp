@@ -0,0 +1,49 @@
+#include "Zobrist.h"
+
+// white men, white kings, black men and black kings, one number per square
+// (generated once with splitmix64)
+const uint64_t Zobrist::PIECE_KEYS[4][32] =
+{
+    { // white men
+        0x05979A6FB100C564ULL, 0xC3A613474B9C8003ULL, 0xE2AAD84E65CEFDC5ULL, 0x0ABC52072BC6CAE3ULL,
+        0x2EC719D4AC7D1137ULL, 0x62F6DB672DB01F89ULL, 0x4F42B5A32474E0E3ULL, 0x1C3C92F9990904E2ULL,
+        0x85194374BC4559F0ULL, 0xA510FDE0B77116EFULL, 0xE57FDE98BAC00086ULL, 0x7674BD023577A9FEULL,
+        0xCADDC4A7E7368CDCULL, 0x20C61C90D511DEF1ULL, 0x97405568C2FC9E5FULL, 0x9AFAECAE556BF72CULL,
+        0xFCE9D2CDF763EF48ULL, 0x9102F795D64DBEC7ULL, 0x6C92DCBBC40266FBULL, 0xA6D4EFA2F6FFF266ULL,
+        0xFF71673751D73049ULL, 0x30ED8146C017637BULL, 0xEC0FE462460B3FD1ULL, 0x1A6D62C3E370ED61ULL,
+        0x4D17083A531D61DCULL, 0x967F9010011C7CA5ULL, 0x8ED0B9E88AAB7C37ULL, 0x5B928952090F9F5BULL,
+        0x2E2BD4613B1025D2ULL, 0x2D8589E680EE8493ULL, 0x3BA84826DFFB9EDCULL, 0xCA4EEF2A84C37AC1ULL
+    },
+    { // white kings
+        0xA37485A8E2E36853ULL, 0xA92D90743EF91E1AULL, 0x12B69DCCDE99BD82ULL, 0x56DE48E0CDD1F423ULL,
+        0x9230B186EB1CBC55ULL, 0x0BD85B940BE5749CULL, 0xE715A13D3B4F609EULL, 0x0ED89C08E78FB3BFULL,
+        0x77C7F918367E551CULL, 0xE4B4FB7CC6040F47ULL, 0xC35BA54EBCF7975BULL, 0xE6F7D4EABA64AD2FULL,
+        0x24967C5640EF233AULL, 0x4751A9BECD3F1B60ULL, 0x8EB4AD8FDDE0282EULL, 0x30AC4E02741C3555ULL,
+        0x4B03473CF7D37B14ULL, 0xE72621867DCE1DD9ULL, 0xCB055BF09039F965ULL, 0xFF35D05A36FCF98FULL,
+        0x6F3C10AD93AA3E67ULL, 0x39A5B3CB95337BADULL, 0x915169E913FF633BULL, 0xACD6476FB48A146CULL,
+        0xD13B21EF70D91D22ULL, 0x9BCCF6C8106677A9ULL, 0x57DE3E39D4CF7BE8ULL, 0x6B7BAC38FD92B710ULL,
+        0x8EB9CE504651E070ULL, 0xDE5A1842896F2041ULL, 0x03F081F407EB2781ULL, 0x1A98BF7359BC351CULL
+    },
+    { // black men
+        0x33E478A2EEA2F5EBULL, 0xF22E24046B2C4DA8ULL, 0xDAD91075B22E57E1ULL, 0x421C8773B818C8F3ULL,
+        0x710877A53352C459ULL, 0xEE1CFE50E0A27E35ULL, 0xC8FF083922E21BBFULL, 0x87B61D7850CE4FFBULL,
+        0x75466A2D1350FA41ULL, 0xB10306C2995B6E70ULL, 0x98B85B633DCDBD76ULL, 0xBBE0EC30557169CAULL,
+        0x6B76EBFB5B8F4518ULL, 0x7536A8CC2584736DULL, 0x5A7E68EEF7EB21D0ULL, 0xE26C349257920B9AULL,
+        0x8526ABE31074C771ULL, 0x98CA1CC8C9025430ULL, 0x4C98D65861116500ULL, 0x40CE4ADFF5D67676ULL,
+        0xED98C0B1B1F3D5C0ULL, 0xACFA67653D7908B7ULL, 0x3975E4075E7C05ADULL, 0x23BC926D25E132ABULL,
+        0x43ADB21B40F50526ULL, 0x65584829AC208C32ULL, 0x4B7F5EA08B38D70CULL, 0xB28FD2D7C1C9B58FULL,
+        0x3986B4E8029E4AA7ULL, 0xCFD965620C4CC5F0ULL, 0x69E75B9F96EFBEA3ULL, 0xB1A62E08F0894016ULL
+    },
+    { // black kings
+        0x8AB77B0FF9BD9519ULL, 0xF6261E25FCFCF1D2ULL, 0x9BFF4F48AD6F7457ULL, 0x9EE6DF69EE1159DFULL,
+        0x33D4D44E47C1DC52ULL, 0xA96BDD450496F323ULL, 0x0CF6539216977990ULL, 0x533E3CE6C04D310FULL,
+        0x6C4D217A06C7F0A9ULL, 0x1213E80C98A96402ULL, 0x35D68CE3DE1DF1CBULL, 0xB1636562FA0B37D9ULL,
+        0xBD31A672A652C5CCULL, 0x1CA4F1A6829BE69AULL, 0x4716228EF6B6A58DULL, 0xA9C5FE010F63D316ULL,
+        0x6345CBF5C11C048DULL, 0x05C632431EBB5FC4ULL, 0x074D2031721D782EULL, 0xA120731C3B99EE48ULL,
+        0x8DD810ADB95F30D8ULL, 0x53122885887FD824ULL, 0xAEC97DC5D380054AULL, 0x18F4FB5C5A225CA7ULL,
+        0xE5C24B411C468F72ULL, 0x86C9D9A8B57E0217ULL, 0xEDD9AB1C7B72FE95ULL, 0x4E617761792F9130ULL,
+        0xEBCF4AE1D73F068FULL, 0xEED10DF559418F6EULL, 0x4BD0834A899A7A3AULL, 0xE2FD6B238A12CA7FULL
+    }
+};
+
+const uint64_t Zobrist::SIDE_KEY = 0xF4496D2F7D01E602ULL;
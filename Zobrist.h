@@ -0,0 +1,37 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <cstdint>
+
+/**
+ * Holds the random numbers used to give every position a (nearly) unique 64-bit key.
+ * A position's key is all the numbers of its pieces XORed together (plus one more if it is
+ * black's turn), so it can be updated with a single XOR as each piece moves.
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+class Zobrist
+{
+	public:
+		/**
+		 * @return Returns the number for a piece of the given kind on the given square
+		 * @param square The square number, 0-31
+		 * @param isWhite The color of the piece
+		 * @param isKing Whether the piece is a king
+		 */
+		static uint64_t getPieceKey(int square, bool isWhite, bool isKing)
+		{ return PIECE_KEYS[(isWhite ? 0 : 2) + (isKing ? 1 : 0)][square]; }
+
+		/**
+		 * @return Returns the number included in the key when it is black's turn to move
+		 */
+		static uint64_t getSideKey() { return SIDE_KEY; }
+
+	private:
+		// fixed (rather than generated at startup) so that keys are the same in every run
+		static const uint64_t PIECE_KEYS[4][32];
+		static const uint64_t SIDE_KEY;
+};
+
+#endif
@@ -0,0 +1,373 @@
+#include "Board.h"
+#include "GameState.h"
+#include "Move.h"
+#include "MoveList.h"
+#include "Piece.h"
+#include "Position.h"
+#include "Typedefs.h"
+
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <new>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+/**
+ * File responsible for timing the game's hot paths on their own (microbenchmarks): generating a piece's
+ * moves and jumps, finding the pieces a move jumps, applying moves to a board, copying a board, generating
+ * a side's legal moves, and the check for the end of the game that runs after every move (see GameState).
+ *
+ * Every benchmark runs over the same corpus of positions: random games played from the start with a fixed
+ * seed, so the numbers are repeatable and can be compared before and after a change. Each one is run several
+ * times, and reports the average nanoseconds per operation, how much that varied between runs (the standard
+ * deviation, as a percentage of the average), the fastest run, and how many memory allocations each
+ * operation made.
+ *
+ * Usage: ./bench [-runs count] [-games count] [-seed number] [benchmark names...]
+ * where giving names only runs the benchmarks with those names.
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+
+// the longest a corpus game can go on for
+static const int MAX_GAME_PLIES = 150;
+
+// allocations made so far, counted by the operator new below
+static long long allocations = 0;
+
+void* operator new(std::size_t size)
+{
+	allocations++;
+	void* memory = std::malloc(size > 0 ? size : 1);
+	if (memory == nullptr)
+		throw std::bad_alloc();
+	return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+/**
+ * The positions every benchmark runs over.
+ */
+struct Corpus
+{
+	std::vector<std::vector<Move>> games; // the moves of each game, from the start
+	std::vector<Board> boards;            // every position of every game (before each move)
+	std::vector<std::vector<Move>> jumps; // the jumps of either side on each board
+	long long pieces = 0;                 // the pieces on all the boards together
+};
+
+/**
+ * The time and allocations one run of a benchmark took.
+ */
+struct Run
+{
+	double nanoseconds = 0;
+	long long allocations = 0;
+	long long operations = 0;
+};
+
+// keeps the compiler from optimizing the benchmarked work away
+static volatile long long sink;
+
+/**
+ * Plays random games from the start to make the corpus.
+ * @param games The number of games
+ * @param seed Decides the moves (so the same seed always gives the same corpus)
+ * @return Returns the corpus
+ */
+static Corpus makeCorpus(int games, uint64_t seed)
+{
+	std::mt19937_64 random(seed);
+	Corpus corpus;
+	for (int game = 0; game < games; game++)
+	{
+		Board board;
+		std::vector<Move> moves;
+		for (int ply = 0; ply < MAX_GAME_PLIES; ply++)
+		{
+			// the game ends as soon as either side can't move (see GameState)
+			Position position = board.getPosition();
+			position.setWhiteToMove(ply % 2 == 0);
+			if (!position.hasMoves(true) || !position.hasMoves(false))
+				break;
+
+			MoveList legal;
+			position.getMoves(legal);
+			Move move = legal[random() % legal.size()];
+
+			corpus.boards.push_back(board);
+			moves.push_back(move);
+
+			corpus.jumps.push_back(std::vector<Move>());
+			for (int side = 0; side < 2; side++)
+			{
+				MoveList jumps;
+				position.setWhiteToMove(side == 0);
+				position.getJumps(jumps);
+				corpus.jumps.back().insert(corpus.jumps.back().end(), jumps.begin(), jumps.end());
+			}
+			corpus.pieces += Position::countSquares(~position.getEmptySquares());
+			board.applyMoveToBoard(move);
+		}
+		corpus.games.push_back(moves);
+	}
+	return corpus;
+}
+
+/**
+ * Times a piece of work, counting the allocations it makes, and adds it to a run.
+ * (The work should be long enough that reading the clock twice is lost in it)
+ * @param run The run to add to
+ * @param operations The number of operations the work does
+ * @param work The work
+ */
+template <typename Work>
+static void measure(Run& run, long long operations, const Work& work)
+{
+	long long allocationsBefore = allocations;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	work();
+	run.nanoseconds += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	run.allocations += allocations - allocationsBefore;
+	run.operations += operations;
+}
+
+/**
+ * Generates the moves of every piece of every board (one operation a piece).
+ */
+static Run benchPieceMoves(const Corpus& corpus)
+{
+	Run run;
+	measure(run, corpus.pieces, [&]()
+	{
+		for (const Board& board : corpus.boards)
+		{
+			for (int pos = 0; pos < Board::SIZE * Board::SIZE; pos++)
+			{
+				if (board.hasPieceAt(pos))
+					sink += board.getValueAt(pos).getAllPossibleMoves(board).size();
+			}
+		}
+	});
+	return run;
+}
+
+/**
+ * Generates the jumps of every piece of every board (one operation a piece).
+ */
+static Run benchPieceJumps(const Corpus& corpus)
+{
+	Run run;
+	measure(run, corpus.pieces, [&]()
+	{
+		for (const Board& board : corpus.boards)
+		{
+			for (int pos = 0; pos < Board::SIZE * Board::SIZE; pos++)
+			{
+				if (board.hasPieceAt(pos))
+					sink += board.getValueAt(pos).getAllPossibleJumps(board).size();
+			}
+		}
+	});
+	return run;
+}
+
+/**
+ * Finds the pieces jumped by every jump of either side on every board (one operation a jump).
+ */
+static Run benchJumpedPieces(const Corpus& corpus)
+{
+	long long operations = 0;
+	for (unsigned int i = 0; i < corpus.jumps.size(); i++)
+		operations += corpus.jumps[i].size();
+
+	Run run;
+	measure(run, operations, [&]()
+	{
+		for (unsigned int i = 0; i < corpus.boards.size(); i++)
+		{
+			for (const Move& jump : corpus.jumps[i])
+				sink += jump.getJumpedPieces(corpus.boards[i]).size();
+		}
+	});
+	return run;
+}
+
+/**
+ * Replays every game on a new board (one operation a move).
+ */
+static Run benchApplyMove(const Corpus& corpus)
+{
+	Run run;
+	for (const std::vector<Move>& game : corpus.games)
+	{
+		Board board;
+		measure(run, game.size(), [&]()
+		{
+			for (const Move& move : game)
+				board.applyMoveToBoard(move);
+		});
+		sink += board.getPosition().getKey();
+	}
+	return run;
+}
+
+/**
+ * Copies every board, and then destroys the copy (one operation a board).
+ */
+static Run benchBoardCopy(const Corpus& corpus)
+{
+	Run run;
+	measure(run, corpus.boards.size(), [&]()
+	{
+		for (const Board& board : corpus.boards)
+		{
+			Board copy(board);
+			sink += copy.hasPieceAt(0);
+		}
+	});
+	return run;
+}
+
+/**
+ * Generates the legal moves of the side to move on every board (one operation a board).
+ */
+static Run benchLegalMoves(const Corpus& corpus)
+{
+	Run run;
+	measure(run, corpus.boards.size(), [&]()
+	{
+		for (const Board& board : corpus.boards)
+		{
+			MoveList moves;
+			board.generateLegalMoves(board.getPosition().isWhiteToMove(), moves);
+			sink += moves.size();
+		}
+	});
+	return run;
+}
+
+/**
+ * Checks every board for the end of the game, as the game does after every move (one operation a board).
+ */
+static Run benchEndGame(const Corpus& corpus)
+{
+	Run run;
+	measure(run, corpus.boards.size(), [&]()
+	{
+		for (const Board& board : corpus.boards)
+		{
+			GameState game(board);
+			sink += game.isOver();
+		}
+	});
+	return run;
+}
+
+/**
+ * A benchmark, by name.
+ */
+struct Benchmark
+{
+	const char* name;
+	Run (*run)(const Corpus& corpus);
+};
+
+static const Benchmark BENCHMARKS[] =
+{
+	{ "piecemoves", benchPieceMoves },
+	{ "piecejumps", benchPieceJumps },
+	{ "jumpedpieces", benchJumpedPieces },
+	{ "applymove", benchApplyMove },
+	{ "boardcopy", benchBoardCopy },
+	{ "legalmoves", benchLegalMoves },
+	{ "endgame", benchEndGame },
+};
+
+int main(int argc, char* argv[])
+{
+	using namespace std;
+
+	int runs = 10;
+	int games = 100;
+	uint64_t seed = 2016;
+	vector<string> names;
+
+	for (int i = 1; i < argc; i++)
+	{
+		string name = argv[i];
+		if (name == "-runs" && i + 1 < argc)
+			runs = atoi(argv[++i]);
+		else if (name == "-games" && i + 1 < argc)
+			games = atoi(argv[++i]);
+		else if (name == "-seed" && i + 1 < argc)
+			seed = strtoull(argv[++i], nullptr, 10);
+		else if (name[0] != '-')
+			names.push_back(name);
+		else
+		{
+			cout << "Unknown option: " << name << '\n';
+			return 1;
+		}
+	}
+	if (runs < 1)
+		runs = 1;
+
+	Corpus corpus = makeCorpus(games, seed);
+	cout << "Corpus: " << corpus.games.size() << " games, " << corpus.boards.size() << " positions (seed " << seed
+	     << "), " << runs << " runs each\n\n";
+	cout << left << setw(14) << "benchmark" << right << setw(12) << "ns/op" << setw(9) << "+/- %" << setw(12)
+	     << "best ns/op" << setw(12) << "allocs/op" << setw(12) << "ops/run" << '\n';
+
+	for (const Benchmark& benchmark : BENCHMARKS)
+	{
+		bool wanted = names.empty();
+		for (unsigned int i = 0; i < names.size(); i++)
+			wanted = wanted || names[i] == benchmark.name;
+		if (!wanted)
+			continue;
+
+		// one run first to warm the caches, which isn't counted
+		benchmark.run(corpus);
+
+		vector<double> times;
+		Run total;
+		for (int i = 0; i < runs; i++)
+		{
+			Run run = benchmark.run(corpus);
+			times.push_back(run.operations > 0 ? run.nanoseconds / run.operations : 0);
+			total.allocations += run.allocations;
+			total.operations += run.operations;
+		}
+
+		double mean = 0, best = times[0];
+		for (double time : times)
+		{
+			mean += time / runs;
+			best = min(best, time);
+		}
+		double variance = 0;
+		for (double time : times)
+			variance += (time - mean) * (time - mean) / runs;
+
+		cout << left << setw(14) << benchmark.name << right << fixed << setprecision(1) << setw(12) << mean
+		     << setw(9) << (mean > 0 ? 100 * sqrt(variance) / mean : 0) << setw(12) << best << setprecision(2)
+		     << setw(12) << (total.operations > 0 ? (double)total.allocations / total.operations : 0)
+		     << setw(12) << total.operations / runs << '\n';
+	}
+	return 0;
+}
@@ -0,0 +1,296 @@
+#include "Board.h"
+#include "Evaluator.h"
+#include "Move.h"
+#include "MoveList.h"
+#include "Position.h"
+#include "Search.h"
+#include "TranspositionTable.h"
+#include "OpeningBook.h"
+#include "PdnReader.h"
+#include "Typedefs.h"
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <unordered_set>
+#include <deque>
+#include <utility>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * File responsible for building the opening book (see OpeningBook.h) the AI plays its first moves from.
+ *
+ * By default the book is grown from the starting position by searching every move of every position
+ * in it: the moves scoring within the margin of the best are added (the closer, the heavier), and the
+ * positions they lead to are searched in turn, a ply at a time, until the given number of plies or
+ * positions is reached.
+ *
+ * It can instead be built from a file of game records, one game per line, written as moves in
+ * checkers notation (move numbers like "1." are skipped) and optionally ending with the result
+ * ("1-0" if White won, "0-1" if Black won, "1/2-1/2" for a draw). Every move played by the winner
+ * or in a draw is added, weighted by how often it was played, and the loser's moves are left out.
+ * An archive of games in PDN (see PdnReader.h) is read the same way.
+ *
+ * Usage: ./bookgen [plies] [-depth depth] [-margin score] [-positions count] [-hash megabytes]
+ *        [-threads count] [-games file] [-pdn file] [-out file]
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+
+/**
+ * Grows a book by searching, from the positions already in it.
+ */
+class BookSearcher
+{
+	public:
+		BookSearcher(int plies, int depth, int margin, size_t maxPositions, size_t hashSize, int threads) :
+			plies(plies), depth(depth), margin(margin), maxPositions(maxPositions), table(hashSize), threads(threads) {};
+
+		/**
+		 * Adds the good moves of every position reached from a position (up to the limits) to the book.
+		 * @param start The position to grow the book from
+		 * @param entries The book's entries, which are added to
+		 */
+		void expand(const Position& start, std::vector<OpeningBook::Entry>& entries)
+		{
+			// go a ply at a time, so that running out of positions leaves every line as deep as each other
+			std::deque<std::pair<Position, int>> queue;
+			queue.push_back(std::make_pair(start, 0));
+			visited.insert(start.getKey());
+
+			while (!queue.empty())
+			{
+				Position position = queue.front().first;
+				int ply = queue.front().second;
+				queue.pop_front();
+
+				std::vector<Move> moves;
+				addMoves(position, moves, entries);
+
+				for (unsigned int i = 0; i < moves.size(); i++)
+				{
+					Position next = position;
+					next.applyMove(moves[i]);
+					if (ply + 1 < plies && visited.size() < maxPositions && visited.insert(next.getKey()).second)
+						queue.push_back(std::make_pair(next, ply + 1));
+				}
+			}
+		}
+
+		/**
+		 * @return Returns the number of positions that have been searched
+		 */
+		size_t getPositions() const { return visited.size(); }
+
+	private:
+		const int plies;
+		const int depth;
+		const int margin;
+		const size_t maxPositions;
+		TranspositionTable table;
+		const int threads;
+		std::unordered_set<uint64_t> visited;
+
+		/**
+		 * Adds the moves of a position that score within the margin of the best to the book.
+		 * @param position The position
+		 * @param moves Filled with the moves that were added
+		 * @param entries The book's entries, which are added to
+		 */
+		void addMoves(Position& position, std::vector<Move>& moves, std::vector<OpeningBook::Entry>& entries)
+		{
+			MoveList legalMoves;
+			position.getMoves(legalMoves);
+
+			// score each move by searching the position it leads to, from the opponent's point of view
+			SearchLimits limits;
+			limits.depth = depth > 1 ? depth - 1 : 1;
+			std::vector<int> scores(legalMoves.size());
+			int best = -Search::WIN_SCORE;
+			for (unsigned int i = 0; i < legalMoves.size(); i++)
+			{
+				UndoRecord undo;
+				position.makeMove(legalMoves[i], undo);
+				Search search(table, threads);
+				scores[i] = -search.run(position, limits).score;
+				position.unmakeMove(undo);
+
+				if (scores[i] > best)
+					best = scores[i];
+			}
+
+			for (unsigned int i = 0; i < legalMoves.size(); i++)
+			{
+				if (scores[i] < best - margin)
+					continue;
+
+				OpeningBook::Entry entry = { position.getKey(), Search::encodeMove(legalMoves[i]),
+				                             (uint16_t)(margin + 1 - (best - scores[i])), 0 };
+				entries.push_back(entry);
+				moves.push_back(legalMoves[i]);
+			}
+		}
+};
+
+/**
+ * Adds the moves of the games in a file to a book.
+ * @param path The file of games (see the top of this file)
+ * @param plies The number of plies to add from the start of each game
+ * @param entries The book's entries, which are added to
+ * @return Returns the number of games read, or -1 if the file couldn't be read
+ */
+static int readGames(const std::string& path, int plies, std::vector<OpeningBook::Entry>& entries)
+{
+	using namespace std;
+
+	ifstream file(path);
+	if (!file)
+		return -1;
+
+	int games = 0;
+	string line;
+	while (getline(file, line))
+	{
+		// split the game into its moves and result
+		istringstream tokens(line);
+		vector<string> moves;
+		int winner = 0; // 1 if White won, -1 if Black won, 0 otherwise
+		string token;
+		while (tokens >> token)
+		{
+			if (token == "1-0")
+				winner = 1;
+			else if (token == "0-1")
+				winner = -1;
+			else if (token == "1/2-1/2" || token == "*")
+				winner = 0;
+			else if (token.back() != '.')
+				moves.push_back(token);
+		}
+		if (moves.empty())
+			continue;
+
+		Board board;
+		Position position = board.getPosition();
+		for (unsigned int i = 0; i < moves.size() && (int)i < plies; i++)
+		{
+			Move move;
+			if (!position.findMove(moves[i], move))
+			{
+				cout << "Illegal move " << moves[i] << " in game " << games + 1 << '\n';
+				break;
+			}
+
+			int mover = position.isWhiteToMove() ? 1 : -1;
+			if (winner != -mover)
+			{
+				OpeningBook::Entry entry = { position.getKey(), Search::encodeMove(move), 1, 0 };
+				entries.push_back(entry);
+			}
+			position.applyMove(move);
+		}
+		games++;
+	}
+	return games;
+}
+
+int main(int argc, char* argv[])
+{
+	using namespace std;
+
+	// search with the same evaluation as the engine
+	Evaluator::loadWeights(Evaluator::DEFAULT_WEIGHTS_FILE);
+
+	int plies = 10;
+	int depth = 10;
+	int margin = 20;
+	size_t maxPositions = 5000;
+	size_t hashSize = 64;
+	int threads = 1;
+	string gamesFile;
+	string pdnFile;
+	string outFile = "openings.book";
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-depth") == 0 && i + 1 < argc)
+			depth = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-margin") == 0 && i + 1 < argc)
+			margin = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-positions") == 0 && i + 1 < argc)
+			maxPositions = strtoul(argv[++i], nullptr, 10);
+		else if (strcmp(argv[i], "-hash") == 0 && i + 1 < argc)
+			hashSize = strtoul(argv[++i], nullptr, 10);
+		else if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc)
+			threads = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-games") == 0 && i + 1 < argc)
+			gamesFile = argv[++i];
+		else if (strcmp(argv[i], "-pdn") == 0 && i + 1 < argc)
+			pdnFile = argv[++i];
+		else if (strcmp(argv[i], "-out") == 0 && i + 1 < argc)
+			outFile = argv[++i];
+		else
+			plies = atoi(argv[i]);
+	}
+	if (margin < 0 || margin > 0xFFFE)
+		margin = 20;
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	vector<OpeningBook::Entry> entries;
+
+	if (!pdnFile.empty())
+	{
+		PdnReader reader;
+		if (!reader.open(pdnFile))
+		{
+			cout << "Could not read " << pdnFile << '\n';
+			return 1;
+		}
+
+		reader.read([&](const Position& position, const Move& move, int result, int ply)
+		{
+			bool lost = result == (position.isWhiteToMove() ? PdnReader::BLACK_WIN : PdnReader::WHITE_WIN);
+			if (ply < plies && !lost)
+			{
+				OpeningBook::Entry entry = { position.getKey(), Search::encodeMove(move), 1, 0 };
+				entries.push_back(entry);
+			}
+		});
+		cout << "Read " << reader.getGames() << " games (" << reader.getErrors() << " with illegal moves)\n";
+	}
+	else if (!gamesFile.empty())
+	{
+		int games = readGames(gamesFile, plies, entries);
+		if (games < 0)
+		{
+			cout << "Could not read " << gamesFile << '\n';
+			return 1;
+		}
+		cout << "Read " << games << " games\n";
+	}
+	else
+	{
+		BookSearcher searcher(plies, depth, margin, maxPositions, hashSize, threads);
+		Board board;
+		searcher.expand(board.getPosition(), entries);
+		cout << "Searched " << searcher.getPositions() << " positions\n";
+	}
+
+	size_t written = OpeningBook::write(outFile, entries);
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	if (written == 0)
+	{
+		cout << "Could not write " << outFile << '\n';
+		return 1;
+	}
+
+	cout << "Wrote " << written << " moves to " << outFile << " in " << fixed << setprecision(2) << seconds
+	     << " seconds\n";
+	return 0;
+}
@@ -1,166 +1,145 @@
-#include "Player.h"
-#include "AIPlayer.h"
-#include "HumanPlayer.h"
-#include "Board.h"
-#include "Piece.h"
-#include "Move.h"
-
-#include <vector>
-#include <iostream>
-
-/**
- * File responsible for determining the gamemode (1- or 2-player), running the game, and handling game exit.
- *
- * @author Mckenna Cisler
- * @version 5.18.2016
- */
-
-bool isPlayer1 = true;
-bool endGameNow = false; // an easily accesible "end" variable
-
-/**
- * Clears the terminal screen
- */
-void clearScreen()
-{
-	// see http://stackoverflow.com/a/32008479/3155372
-	std::cout << "\033[2J\033[1;1H"; 
-}
-
-/**
- * Responsible for quickly ending the game
- */
-void triggerEndGame()
-{
-	endGameNow = true;
-}
-
-/**
- * Queries the user to determine the requested gamemode
- * @return Returns true if the user wants two-player mode,
- * else false if they want one-player mode.
- */
-bool askIfTwoPlayer()
-{
-	// keep asking to get a valid response
-	while (true)
-	{
-		using namespace std;
-	
-	    // display message
-	    clearScreen();
-	    cout << "*******Welcome to checkers!*******\n" << '\n';
-	    cout << "Enter 'exit' to exit at any point (or 0 when moving a piece).\n" << '\n';
-	    cout << "We offer two game modes:"<< '\n';
-	    cout << "[1] 1 Player Mode (vs Computer) - EXPERIMENTAL" << '\n';
-	    cout << "[2] 2 Player Mode"<< '\n';
-	    cout << "\nWhich one would you like to play? Enter a number: " << '\n';
-
-	    // ask for string, but only accept "1" or "2"
-	    string response;
-	    getline(cin, response);
-	    if (response == "1")  // TODO: trim whitespace
-            return false;
-	    else if (response == "2")
-            return true;
-        else if (response == "exit")
-        {
-            triggerEndGame();
-            return true;
-        }
-    }
-}
-
-/**
- * Determines whether the game has been completed, or is in a stalemate
- * @param board The board to check to determine if we're at an endgame point.
- */
-bool endGame(const Board& board)
-{
-	// have an emergency trigger for endgame
-	if (endGameNow)
-	    return true;
-	else
-	{
-	    // otherwise search the board for pieces of both colors, and if none of one color are present,
-	    // the other player has won.
-	    int movableWhiteNum = 0;
-	    int movableBlackNum = 0;
-	    for (int pos = 0; pos < Board::SIZE*Board::SIZE; pos++)
-	    {
-	        // make sure the piece exists, and if so sum movable pieces for each color)
-	        Piece* pieceHere = board.getValueAt(pos);
-	        if (pieceHere != nullptr)
-	        {
-	            // only consider piece if it has possible moves
-	            if (!pieceHere->getAllPossibleMoves(board).empty())
-	            {
-	                if (pieceHere->isWhite)
-	                    movableWhiteNum++;
-	                else
-	                    movableBlackNum++;
-	            }
-	        }
-	    }
-		
-		using namespace std;
-		
-	    // determine if anyone won (or if no one had any moves left)
-	    if (movableWhiteNum + movableBlackNum == 0)
-	        cout << "The game was a stalemate..." << endl;
-	    else if (movableWhiteNum == 0)
-	        cout << "Congratulations, Black, you have won the game gloriously!" << endl;
-	    else if (movableBlackNum == 0)
-	        cout << "Congratulations, White, you have won the game gloriously!" << endl;
-	    else
-	        return false;
-
-	    // we can only make it here if any of the above conditions are hit
-	    return true;
-	}
-}
-
-int main()
-{
-	// generate basic board and setup
-	Board board;
-
-	// define abstract classes, to be assigned a concrete class after deciding gamemode
-	// defined as pointers and dynamically allocated in order to use polymorphism
-	Player* player1;
-	Player* player2;
-
-	if (askIfTwoPlayer())
-	{
-	    player1 = new HumanPlayer(true);
-	    player2 = new HumanPlayer(false);
-	}
-	else
-	{
-	    player1 = new HumanPlayer(true);
-	    //player2 = new HumanPlayer(false);
-	    player2 = new AIPlayer(false);
-	}
-	clearScreen();
-
-	while ( !endGame(board) )
-	{
-	    if (isPlayer1)
-	    {
-	        player1->getMove(board);
-	    }
-	    else
-	    {
-	        player2->getMove(board);
-	    }
-
-	    // switch players
-	    isPlayer1 = !isPlayer1;
-	}
-	
-	delete player1;
-	delete player2;
-	
-	return 0;
-}
-
+#include "Player.h"
+#include "AIPlayer.h"
+#include "HumanPlayer.h"
+#include "Board.h"
+#include "Piece.h"
+#include "Move.h"
+#include "EngineProtocol.h"
+#include "Evaluator.h"
+#include "GameState.h"
+
+#include <vector>
+#include <iostream>
+#include <cstring>
+
+/**
+ * File responsible for determining the gamemode (1- or 2-player), running the game, and handling game exit.
+ * Run with --engine to drive the engine with text commands instead (see EngineProtocol.h).
+ *
+ * @author Mckenna Cisler
+ * @version 5.18.2016
+ */
+
+/**
+ * Clears the terminal screen
+ */
+void clearScreen()
+{
+	// see http://stackoverflow.com/a/32008479/3155372
+	std::cout << "\033[2J\033[1;1H"; 
+}
+
+/**
+ * Queries the user to determine the requested gamemode
+ * @param game The game, which is ended if the user exits instead
+ * @return Returns true if the user wants two-player mode,
+ * else false if they want one-player mode.
+ */
+bool askIfTwoPlayer(GameState& game)
+{
+	// keep asking to get a valid response
+	while (true)
+	{
+		using namespace std;
+	
+	    // display message
+	    clearScreen();
+	    cout << "*******Welcome to checkers!*******\n" << '\n';
+	    cout << "Enter 'exit' to exit at any point (or 0 when moving a piece).\n" << '\n';
+	    cout << "We offer two game modes:"<< '\n';
+	    cout << "[1] 1 Player Mode (vs Computer) - EXPERIMENTAL" << '\n';
+	    cout << "[2] 2 Player Mode"<< '\n';
+	    cout << "\nWhich one would you like to play? Enter a number: " << '\n';
+
+	    // ask for string, but only accept "1" or "2"
+	    string response;
+	    getline(cin, response);
+	    if (response == "1")  // TODO: trim whitespace
+            return false;
+	    else if (response == "2")
+            return true;
+        else if (response == "exit")
+        {
+            game.quit();
+            return true;
+        }
+    }
+}
+
+/**
+ * Tells the players how the game ended (if it wasn't by someone exiting)
+ * @param game The game, which is over
+ */
+void announceOutcome(const GameState& game)
+{
+	using namespace std;
+
+	if (game.getOutcome() == GameState::STALEMATE)
+	    cout << "The game was a stalemate..." << endl;
+	else if (game.getOutcome() == GameState::BLACK_WINS)
+	    cout << "Congratulations, Black, you have won the game gloriously!" << endl;
+	else if (game.getOutcome() == GameState::WHITE_WINS)
+	    cout << "Congratulations, White, you have won the game gloriously!" << endl;
+}
+
+int main(int argc, char* argv[])
+{
+	// use tuned evaluation weights if there are any (before any positions are set up, see Evaluator::setWeights)
+	Evaluator::loadWeights(Evaluator::DEFAULT_WEIGHTS_FILE);
+
+	// other programs talk to the engine directly, without the game around it
+	if (argc > 1 && strcmp(argv[1], "--engine") == 0)
+	{
+		EngineProtocol protocol(std::cin, std::cout);
+		protocol.run();
+		return 0;
+	}
+
+	// generate basic board and setup, and keep track of whose turn it is and when the game ends
+	Board board;
+	GameState game(board);
+
+	// define abstract classes, to be assigned a concrete class after deciding gamemode
+	// defined as pointers and dynamically allocated in order to use polymorphism
+	Player* player1;
+	Player* player2;
+
+	if (askIfTwoPlayer(game))
+	{
+	    player1 = new HumanPlayer(true, game);
+	    player2 = new HumanPlayer(false, game);
+	}
+	else
+	{
+	    player1 = new HumanPlayer(true, game);
+	    //player2 = new HumanPlayer(false);
+
+	    // the computer thinks ahead while the person decides on their move
+	    AIPlayer* computer = new AIPlayer(false);
+	    computer->setPondering(true);
+	    player2 = computer;
+	}
+	clearScreen();
+
+	while ( !game.isOver() )
+	{
+	    if (game.isWhiteToMove())
+	    {
+	        player1->getMove(board);
+	    }
+	    else
+	    {
+	        player2->getMove(board);
+	    }
+
+	    // switch players (which also checks whether the game is over)
+	    game.nextTurn(board);
+	}
+	announceOutcome(game);
+	
+	delete player1;
+	delete player2;
+	
+	return 0;
+}
+
@@ -0,0 +1,222 @@
+#include "Board.h"
+#include "Move.h"
+#include "MoveList.h"
+#include "Position.h"
+#include "Typedefs.h"
+
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * File responsible for counting every sequence of moves to a given depth ("perft"), which checks
+ * the move generator against known counts and measures how quickly it runs.
+ *
+ * Usage: ./perft [depth] [-divide] [-hash megabytes] [-threads count] [-fen position] [moves...]
+ * where the moves (in checkers notation, such as 9-13) are played first, from the position given
+ * in FEN (see Position::setFromFen) or else the starting position.
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+
+/**
+ * Remembers the counts of subtrees that have already been counted, since the same position is
+ * often reached by different move orders. Safe to share between threads without locks, in the
+ * same way as the TranspositionTable (each slot holds its key XORed with its count).
+ */
+class PerftTable
+{
+	public:
+		PerftTable(size_t megabytes)
+		{
+			size = 1;
+			while (size * 2 * sizeof(Slot) <= megabytes * 1024 * 1024)
+				size *= 2;
+			slots.reset(new Slot[size]);
+			for (size_t i = 0; i < size; i++)
+			{
+				slots[i].check = 0;
+				slots[i].count = 0;
+			}
+		}
+
+		/**
+		 * @return Returns true (and fills count) if the subtree of this position and depth is stored
+		 */
+		bool probe(uint64_t key, int depth, long long& count) const
+		{
+			key = mix(key, depth);
+			Slot& slot = slots[key & (size - 1)];
+			uint64_t stored = slot.count.load(std::memory_order_relaxed);
+			if ((slot.check.load(std::memory_order_relaxed) ^ stored) != key || stored == 0)
+				return false;
+			count = (long long)stored;
+			return true;
+		}
+
+		/**
+		 * Stores the count of the subtree of this position and depth.
+		 */
+		void store(uint64_t key, int depth, long long count)
+		{
+			key = mix(key, depth);
+			Slot& slot = slots[key & (size - 1)];
+			slot.count.store((uint64_t)count, std::memory_order_relaxed);
+			slot.check.store(key ^ (uint64_t)count, std::memory_order_relaxed);
+		}
+
+	private:
+		struct Slot
+		{
+			std::atomic<uint64_t> check;
+			std::atomic<uint64_t> count;
+		};
+
+		std::unique_ptr<Slot[]> slots;
+		size_t size;
+
+		/**
+		 * @return Returns a key for the position at a particular depth (the same position is worth
+		 * a different count at every depth)
+		 */
+		static uint64_t mix(uint64_t key, int depth) { return key ^ (uint64_t)(depth + 1) * 0x9E3779B97F4A7C15ULL; }
+};
+
+/**
+ * Counts the sequences of moves of the given length from a position.
+ * @param position The position to count from (moves are made and unmade on it)
+ * @param depth The number of moves in each sequence
+ * @param table Where to remember subtree counts (may be null to not remember them)
+ * @return Returns the number of sequences (leaf positions)
+ */
+long long perft(Position& position, int depth, PerftTable* table)
+{
+	if (depth == 0)
+		return 1;
+
+	long long count = 0;
+	if (table != nullptr && depth > 1 && table->probe(position.getKey(), depth, count))
+		return count;
+
+	moves_t moves;
+	position.getMoves(moves);
+
+	// the last ply doesn't need to be played, since we only need to know how many moves there are
+	if (depth == 1)
+		return moves.size();
+
+	for (unsigned int i = 0; i < moves.size(); i++)
+	{
+		UndoRecord undo;
+		position.makeMove(moves[i], undo);
+		count += perft(position, depth - 1, table);
+		position.unmakeMove(undo);
+	}
+
+	if (table != nullptr)
+		table->store(position.getKey(), depth, count);
+	return count;
+}
+
+int main(int argc, char* argv[])
+{
+	using namespace std;
+
+	int depth = 6;
+	bool divide = false;
+	size_t hashSize = 0;
+	int threads = 1;
+	vector<string> playedMoves;
+	const char* fen = Position::START_FEN;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-divide") == 0)
+			divide = true;
+		else if (strcmp(argv[i], "-hash") == 0 && i + 1 < argc)
+			hashSize = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc)
+			threads = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-fen") == 0 && i + 1 < argc)
+			fen = argv[++i];
+		else if (i == 1 && strchr(argv[i], '-') == nullptr && strchr(argv[i], 'x') == nullptr)
+			depth = atoi(argv[i]);
+		else
+			playedMoves.push_back(argv[i]);
+	}
+	if (threads < 1)
+		threads = 1;
+
+	// set up the position by playing the given moves from the one given
+	Position position;
+	if (!position.setFromFen(fen, strlen(fen)))
+	{
+		cout << "Invalid position: " << fen << '\n';
+		return 1;
+	}
+	for (unsigned int i = 0; i < playedMoves.size(); i++)
+	{
+		Move move;
+		if (!position.findMove(playedMoves[i], move))
+		{
+			cout << "Illegal move: " << playedMoves[i] << '\n';
+			return 1;
+		}
+		position.applyMove(move);
+	}
+
+	unique_ptr<PerftTable> table;
+	if (hashSize > 0)
+		table.reset(new PerftTable(hashSize));
+
+	// split the work at the root: each thread takes the next root move nobody has counted yet
+	moves_t rootMoves;
+	position.getMoves(rootMoves);
+	vector<long long> counts(rootMoves.size(), 0);
+	atomic<unsigned int> nextMove(0);
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	auto countRootMoves = [&]()
+	{
+		Position threadPosition = position;
+		for (unsigned int i = nextMove++; i < rootMoves.size(); i = nextMove++)
+		{
+			UndoRecord undo;
+			threadPosition.makeMove(rootMoves[i], undo);
+			counts[i] = depth > 0 ? perft(threadPosition, depth - 1, table.get()) : 0;
+			threadPosition.unmakeMove(undo);
+		}
+	};
+
+	vector<thread> workers;
+	for (int i = 1; i < threads; i++)
+		workers.push_back(thread(countRootMoves));
+	countRootMoves();
+	for (unsigned int i = 0; i < workers.size(); i++)
+		workers[i].join();
+
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	long long total = depth > 0 ? 0 : 1;
+	for (unsigned int i = 0; i < rootMoves.size(); i++)
+	{
+		total += counts[i];
+		if (divide)
+			cout << rootMoves[i].getNotation() << ": " << counts[i] << '\n';
+	}
+
+	cout << "perft(" << depth << ") = " << total << '\n';
+	cout << fixed << setprecision(3) << seconds << " seconds, "
+	     << setprecision(0) << (seconds > 0 ? total / seconds : 0) << " nodes/second\n";
+
+	return 0;
+}
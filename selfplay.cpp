@@ -0,0 +1,475 @@
+#include "AIPlayer.h"
+#include "Board.h"
+#include "Evaluator.h"
+#include "Move.h"
+#include "MoveList.h"
+#include "Position.h"
+#include "Typedefs.h"
+
+#include <vector>
+#include <string>
+#include <random>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * File responsible for playing AIPlayers against each other without anyone at the keyboard, to
+ * measure whether a change to the engine (engine A) makes it stronger than it was (engine B).
+ *
+ * Games are played in pairs from the same randomly chosen opening, with each engine taking each
+ * color once, on as many threads as asked for. A game that goes on too long is a draw. Engines can
+ * search to a depth, a number of nodes, a time per move, or on a clock (time for the whole game plus
+ * an increment per move), which they lose the game by running out of. The results
+ * are reduced to wins, draws and losses for engine A, the Elo difference they suggest, and a
+ * sequential probability ratio test (SPRT) of whether A is at least elo1 stronger rather than at
+ * most elo0, which stops the match as soon as it is decided.
+ *
+ * Every position the engines reach can also be written out with how its game ended, one per line
+ * in FEN followed by the result ("1-0" if White won, "0-1" if Black won, "1/2-1/2" for a draw),
+ * for the tune tool to fit the evaluation to. Both engines evaluate with the same weights.
+ *
+ * The statistics of every search (see SearchStats) can be written out too, one move per line in JSON,
+ * like {"game":12,"engine":"A","ply":7,"white":false,"depth":9,"score":-14,"stats":{...}}.
+ *
+ * Usage: ./selfplay [-games count] [-threads count] [-random plies] [-maxplies plies] [-seed number]
+ *        [-sprt elo0 elo1] [-alpha probability] [-beta probability] [-weights file] [-positions file] [-stats file]
+ *        [-depth depth] [-nodes count] [-movetime milliseconds] [-time milliseconds] [-inc milliseconds]
+ *        [-hash megabytes] [-searchthreads count] [-book file] [-tablebases directory]
+ * where each engine setting applies to both engines, or to only one with A or B on the end (like -depthA 9).
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+
+// the fewest games the SPRT can stop the match after (before then, the normal approximation
+// it makes is too far off to trust)
+static const int MIN_SPRT_GAMES = 20;
+
+/**
+ * The settings of one of the engines playing.
+ */
+struct EngineSettings
+{
+	SearchLimits limits;
+	size_t hashSize = AIPlayer::DEFAULT_HASH_SIZE;
+	int threads = 1;
+	std::string book = AIPlayer::DEFAULT_BOOK_FILE;
+	std::string tablebases = AIPlayer::DEFAULT_TABLEBASE_DIRECTORY;
+};
+
+/**
+ * What the search for one move of a game did.
+ */
+struct MoveStats
+{
+	int ply;
+	bool isWhite;      // the side that moved
+	int depth;
+	int score;
+	std::string stats; // the SearchStats, as JSON
+};
+
+/**
+ * The results of the games played so far, from engine A's point of view.
+ */
+struct MatchResults
+{
+	int wins = 0;
+	int draws = 0;
+	int losses = 0;
+	int timeLosses = 0; // of engine A's losses
+	int timeWins = 0;   // of engine A's wins
+
+	int getGames() const { return wins + draws + losses; }
+
+	/**
+	 * @return Returns the fraction of the points engine A scored (a win is 1, and a draw 1/2)
+	 */
+	double getScore() const { return getGames() == 0 ? 0.5 : (wins + draws / 2.0) / getGames(); }
+
+	/**
+	 * @return Returns the Elo difference that would give the same expected score
+	 * @param score The expected score
+	 */
+	static double getElo(double score)
+	{
+		score = std::min(std::max(score, 1e-6), 1 - 1e-6);
+		return -400 * std::log10(1 / score - 1);
+	}
+
+	/**
+	 * @return Returns the expected score of an engine that is the given number of Elo stronger
+	 */
+	static double getExpectedScore(double elo) { return 1 / (1 + std::pow(10, -elo / 400)); }
+
+	/**
+	 * @return Returns the variance of the score of a single game, going by the results so far
+	 */
+	double getVariance() const
+	{
+		if (getGames() == 0)
+			return 0;
+		double score = getScore();
+		return (wins * (1 - score) * (1 - score) + draws * (0.5 - score) * (0.5 - score) + losses * score * score)
+		       / getGames();
+	}
+
+	/**
+	 * @return Returns the amount either side of the Elo difference it is 95% sure to be within
+	 */
+	double getEloMargin() const
+	{
+		if (getGames() == 0)
+			return 0;
+		double deviation = std::sqrt(getVariance() / getGames());
+		return (getElo(getScore() + 1.96 * deviation) - getElo(getScore() - 1.96 * deviation)) / 2;
+	}
+
+	/**
+	 * @return Returns the log-likelihood ratio of engine A being elo1 stronger rather than elo0 stronger
+	 * (using a normal approximation of the score)
+	 */
+	double getLogLikelihoodRatio(double elo0, double elo1) const
+	{
+		double variance = getVariance();
+		if (variance <= 0)
+			return 0;
+		double score0 = getExpectedScore(elo0);
+		double score1 = getExpectedScore(elo1);
+		return getGames() * (score1 - score0) * (2 * getScore() - score0 - score1) / (2 * variance);
+	}
+};
+
+/**
+ * Plays random moves from the starting position to give each pair of games its own opening.
+ * @param plies The number of random moves to play
+ * @param seed Decides the moves (so the same seed always gives the same opening)
+ * @return Returns the moves, which don't end the game
+ */
+static std::vector<Move> getOpening(int plies, uint64_t seed)
+{
+	std::mt19937_64 random(seed);
+	while (true)
+	{
+		Board board;
+		Position position = board.getPosition();
+		std::vector<Move> opening;
+
+		for (int ply = 0; ply < plies; ply++)
+		{
+			MoveList moves;
+			position.getMoves(moves);
+			if (moves.empty())
+				break;
+
+			Move move = moves[random() % moves.size()];
+			position.applyMove(move);
+			opening.push_back(move);
+		}
+
+		if (position.hasMoves(true) && position.hasMoves(false))
+			return opening;
+	}
+}
+
+/**
+ * Sets up an AIPlayer with the given settings.
+ */
+static void setUpPlayer(AIPlayer& player, const EngineSettings& settings)
+{
+	player.setSearchLimits(settings.limits);
+	player.setHashSize(settings.hashSize);
+	player.setThreads(settings.threads);
+	player.setBookFile(settings.book);
+	player.setTablebaseDirectory(settings.tablebases);
+}
+
+/**
+ * Plays one game between the two engines.
+ * @param white The settings of the engine playing White
+ * @param black The settings of the engine playing Black
+ * @param opening The moves to play before the engines take over
+ * @param maxPlies The number of plies after which the game is called a draw
+ * @param positions Filled with every position the engines moved in
+ * @param lostOnTime Set to whether the game was lost by running out of time
+ * @param moveStats Filled with the statistics of every move an engine searched for, or null to not collect them
+ * @return Returns 1 if White won, -1 if Black won, or 0 for a draw
+ */
+static int playGame(const EngineSettings& white, const EngineSettings& black, const std::vector<Move>& opening,
+                    int maxPlies, std::vector<Position>& positions, bool& lostOnTime,
+                    std::vector<MoveStats>* moveStats)
+{
+	lostOnTime = false;
+	AIPlayer whitePlayer(true);
+	AIPlayer blackPlayer(false);
+	setUpPlayer(whitePlayer, white);
+	setUpPlayer(blackPlayer, black);
+
+	Board board;
+	for (unsigned int i = 0; i < opening.size(); i++)
+		board.applyMoveToBoard(opening[i]);
+
+	// each side's clock (only counted for engines playing on one) starts full when the engines take over
+	SearchLimits limits[2] = { white.limits, black.limits };
+	AIPlayer* players[2] = { &whitePlayer, &blackPlayer };
+
+	// White moves first, so whoever is to move is known from the number of moves played
+	for (int ply = opening.size(); ply < maxPlies; ply++)
+	{
+		// the game ends as soon as either side can't move (see GameState)
+		const Position& position = board.getPosition();
+		bool whiteCanMove = position.hasMoves(true);
+		bool blackCanMove = position.hasMoves(false);
+		if (!whiteCanMove || !blackCanMove)
+			return whiteCanMove ? 1 : blackCanMove ? -1 : 0;
+
+		positions.push_back(position);
+		int side = ply % 2;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		if (limits[side].time > 0)
+			players[side]->setSearchLimits(limits[side]);
+		players[side]->getMove(board);
+		int milliseconds = (int)std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now() - start).count();
+
+		// (book moves aren't searched)
+		const SearchResult& result = players[side]->getLastResult();
+		if (moveStats != nullptr && result.stats.nodes > 0)
+		{
+			MoveStats stats = { ply, side == 0, result.depth, result.score, result.stats.toJson() };
+			moveStats->push_back(stats);
+		}
+
+		if (limits[side].time > 0)
+		{
+			limits[side].time -= milliseconds;
+			if (limits[side].time <= 0)
+			{
+				lostOnTime = true;
+				return side == 0 ? -1 : 1;
+			}
+			limits[side].time += limits[side].increment;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Sets an engine setting from the command line.
+ * @param name The name of the setting (without A or B on the end)
+ * @param value The value given
+ * @param settings The settings to change
+ * @return Returns false if there is no such setting
+ */
+static bool setSetting(const std::string& name, const char* value, EngineSettings& settings)
+{
+	if (name == "-depth")
+		settings.limits.depth = atoi(value);
+	else if (name == "-nodes")
+		settings.limits.nodes = atoll(value);
+	else if (name == "-movetime")
+		settings.limits.movetime = atoi(value);
+	else if (name == "-time")
+		settings.limits.time = atoi(value);
+	else if (name == "-inc")
+		settings.limits.increment = atoi(value);
+	else if (name == "-hash")
+		settings.hashSize = strtoul(value, nullptr, 10);
+	else if (name == "-searchthreads")
+		settings.threads = atoi(value);
+	else if (name == "-book")
+		settings.book = value;
+	else if (name == "-tablebases")
+		settings.tablebases = value;
+	else
+		return false;
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	using namespace std;
+
+	int games = 1000;
+	int threads = (int)thread::hardware_concurrency();
+	int randomPlies = 4;
+	int maxPlies = 300;
+	uint64_t seed = 2016;
+	double elo0 = 0, elo1 = 10, alpha = 0.05, beta = 0.05;
+	string weightsFile = Evaluator::DEFAULT_WEIGHTS_FILE;
+	string positionsFile;
+	string statsFile;
+	EngineSettings engines[2];
+
+	for (int i = 1; i + 1 < argc; i++)
+	{
+		string name = argv[i];
+		if (name == "-games")
+			games = atoi(argv[++i]);
+		else if (name == "-threads")
+			threads = atoi(argv[++i]);
+		else if (name == "-random")
+			randomPlies = atoi(argv[++i]);
+		else if (name == "-maxplies")
+			maxPlies = atoi(argv[++i]);
+		else if (name == "-seed")
+			seed = strtoull(argv[++i], nullptr, 10);
+		else if (name == "-alpha")
+			alpha = atof(argv[++i]);
+		else if (name == "-beta")
+			beta = atof(argv[++i]);
+		else if (name == "-weights")
+			weightsFile = argv[++i];
+		else if (name == "-positions")
+			positionsFile = argv[++i];
+		else if (name == "-stats")
+			statsFile = argv[++i];
+		else if (name == "-sprt" && i + 2 < argc)
+		{
+			elo0 = atof(argv[++i]);
+			elo1 = atof(argv[++i]);
+		}
+		else if (setSetting(name, argv[i + 1], engines[0]) && setSetting(name, argv[i + 1], engines[1]))
+			i++;
+		else if ((name.back() == 'A' || name.back() == 'B') &&
+		         setSetting(name.substr(0, name.size() - 1), argv[i + 1], engines[name.back() == 'A' ? 0 : 1]))
+			i++;
+		else
+		{
+			cout << "Unknown option: " << name << '\n';
+			return 1;
+		}
+	}
+	if (threads < 1)
+		threads = 1;
+
+	// (before any positions are set up, see Evaluator::setWeights)
+	if (!Evaluator::loadWeights(weightsFile) && weightsFile != Evaluator::DEFAULT_WEIGHTS_FILE)
+	{
+		cout << "Could not read " << weightsFile << '\n';
+		return 1;
+	}
+
+	ofstream positionsOut;
+	if (!positionsFile.empty())
+	{
+		positionsOut.open(positionsFile);
+		if (!positionsOut)
+		{
+			cout << "Could not write " << positionsFile << '\n';
+			return 1;
+		}
+	}
+
+	ofstream statsOut;
+	if (!statsFile.empty())
+	{
+		statsOut.open(statsFile);
+		if (!statsOut)
+		{
+			cout << "Could not write " << statsFile << '\n';
+			return 1;
+		}
+	}
+
+	// the test is decided once the log-likelihood ratio leaves these bounds
+	double lowerBound = log(beta / (1 - alpha));
+	double upperBound = log((1 - beta) / alpha);
+
+	MatchResults results;
+	mutex resultsLock;
+	atomic<int> nextGame(0);
+	atomic<bool> decided(false);
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	auto playGames = [&]()
+	{
+		for (int game = nextGame++; game < games && !decided; game = nextGame++)
+		{
+			// both games of a pair share an opening, with engine A playing White in the first
+			vector<Move> opening = getOpening(randomPlies, seed + game / 2);
+			bool engineIsWhite = game % 2 == 0;
+			vector<Position> positions;
+			vector<MoveStats> moveStats;
+			bool lostOnTime;
+			int result = playGame(engines[engineIsWhite ? 0 : 1], engines[engineIsWhite ? 1 : 0], opening, maxPlies,
+			                      positions, lostOnTime, statsOut.is_open() ? &moveStats : nullptr);
+
+			lock_guard<mutex> lock(resultsLock);
+			if (positionsOut.is_open())
+			{
+				const char* resultText = result > 0 ? "1-0" : result < 0 ? "0-1" : "1/2-1/2";
+				char fen[Position::MAX_FEN_LENGTH + 1];
+				for (unsigned int i = 0; i < positions.size(); i++)
+				{
+					positions[i].writeFen(fen, sizeof(fen));
+					positionsOut << fen << ' ' << resultText << '\n';
+				}
+			}
+
+			// each move's line says which engine searched it (White is engine A in the first game of a pair)
+			for (unsigned int i = 0; i < moveStats.size(); i++)
+			{
+				const MoveStats& move = moveStats[i];
+				statsOut << "{\"game\":" << game << ",\"engine\":\"" << (move.isWhite == engineIsWhite ? 'A' : 'B')
+				         << "\",\"ply\":" << move.ply << ",\"white\":" << (move.isWhite ? "true" : "false")
+				         << ",\"depth\":" << move.depth << ",\"score\":" << move.score << ",\"stats\":" << move.stats << "}\n";
+			}
+
+			if (!engineIsWhite)
+				result = -result;
+			if (result > 0)
+				results.wins++;
+			else if (result < 0)
+				results.losses++;
+			else
+				results.draws++;
+			if (lostOnTime && result > 0)
+				results.timeWins++;
+			else if (lostOnTime)
+				results.timeLosses++;
+
+			double ratio = results.getLogLikelihoodRatio(elo0, elo1);
+			if (results.getGames() >= MIN_SPRT_GAMES && (ratio <= lowerBound || ratio >= upperBound))
+				decided = true;
+
+			if (results.getGames() % 10 == 0 || decided)
+			{
+				cout << "Games " << results.getGames() << ": +" << results.wins << " =" << results.draws
+				     << " -" << results.losses << fixed << setprecision(1) << ", Elo " << MatchResults::getElo(results.getScore())
+				     << " +/- " << results.getEloMargin() << setprecision(2) << ", LLR " << ratio
+				     << " (" << lowerBound << ", " << upperBound << ")" << endl;
+			}
+		}
+	};
+
+	vector<thread> workers;
+	for (int i = 1; i < threads; i++)
+		workers.push_back(thread(playGames));
+	playGames();
+	for (unsigned int i = 0; i < workers.size(); i++)
+		workers[i].join();
+
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	double ratio = results.getLogLikelihoodRatio(elo0, elo1);
+
+	cout << "\nEngine A: +" << results.wins << " =" << results.draws << " -" << results.losses
+	     << " in " << results.getGames() << " games (" << fixed << setprecision(1) << 100 * results.getScore()
+	     << "%), " << setprecision(2) << seconds << " seconds\n";
+	if (results.timeWins > 0 || results.timeLosses > 0)
+		cout << "On time: engine A won " << results.timeWins << " and lost " << results.timeLosses << '\n';
+	cout << "Elo difference: " << setprecision(1) << MatchResults::getElo(results.getScore())
+	     << " +/- " << results.getEloMargin() << '\n';
+	cout << "SPRT [" << elo0 << ", " << elo1 << "]: LLR " << setprecision(2) << ratio << ", "
+	     << (ratio >= upperBound ? "H1 accepted (A is stronger)"
+	         : ratio <= lowerBound ? "H0 accepted (A is not stronger)" : "inconclusive") << '\n';
+	return 0;
+}
@@ -0,0 +1,107 @@
+#include "Board.h"
+#include "MoveList.h"
+#include "Position.h"
+#include "Search.h"
+#include "TranspositionTable.h"
+#include "Typedefs.h"
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+/**
+ * File responsible for measuring how well the search scales with threads: it searches the same
+ * positions to the same depth with 1, 2, 4... threads, and reports the time each took to get there.
+ *
+ * Usage: ./speedup [depth] [max threads] [hash megabytes]
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+
+/**
+ * Generates a repeatable set of test positions by playing random moves from the starting position.
+ * @param count The number of positions to generate
+ * @return Returns the positions
+ */
+std::vector<Position> generatePositions(int count)
+{
+	std::vector<Position> positions;
+	std::mt19937 random(2016);
+
+	while ((int)positions.size() < count)
+	{
+		Board board;
+		Position position = board.getPosition();
+
+		// play a few random moves into the opening, then keep it if the game isn't over
+		int plies = 4 + random() % 12;
+		for (int ply = 0; ply < plies; ply++)
+		{
+			moves_t moves;
+			position.getMoves(moves);
+
+			if (moves.empty())
+				break;
+			position.applyMove(moves[random() % moves.size()]);
+		}
+
+		if (position.hasMoves(true) && position.hasMoves(false))
+			positions.push_back(position);
+	}
+	return positions;
+}
+
+int main(int argc, char* argv[])
+{
+	using namespace std;
+
+	int depth = argc > 1 ? atoi(argv[1]) : 12;
+	int maxThreads = argc > 2 ? atoi(argv[2]) : (int)thread::hardware_concurrency();
+	int hashSize = argc > 3 ? atoi(argv[3]) : 64;
+	if (maxThreads < 1)
+		maxThreads = 1;
+
+	vector<Position> positions = generatePositions(8);
+	TranspositionTable table(hashSize);
+
+	SearchLimits limits;
+	limits.depth = depth;
+
+	cout << "Searching " << positions.size() << " positions to depth " << depth
+	     << " (" << thread::hardware_concurrency() << " hardware threads)\n";
+	cout << setw(8) << "threads" << setw(12) << "seconds" << setw(14) << "nodes"
+	     << setw(14) << "nodes/sec" << setw(10) << "speedup" << '\n';
+
+	double baseSeconds = 0;
+	for (int threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		double seconds = 0;
+		long long nodes = 0;
+
+		// every position starts with an empty table, so each run does the same work from scratch
+		for (unsigned int i = 0; i < positions.size(); i++)
+		{
+			table.clear();
+			Search search(table, threads);
+
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+			SearchResult result = search.run(positions[i], limits);
+			seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+			nodes += result.nodes;
+		}
+
+		if (threads == 1)
+			baseSeconds = seconds;
+
+		cout << setw(8) << threads << setw(12) << fixed << setprecision(3) << seconds
+		     << setw(14) << nodes << setw(14) << setprecision(0) << nodes / seconds
+		     << setw(10) << setprecision(2) << baseSeconds / seconds << '\n';
+	}
+
+	return 0;
+}
@@ -0,0 +1,440 @@
+#include "Position.h"
+#include "MoveList.h"
+#include "Tablebase.h"
+#include "Typedefs.h"
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+#include <sys/stat.h>
+
+/**
+ * File responsible for generating the endgame tables (see Tablebase.h): the value of every
+ * position with up to the given number of pieces, and how far it is from the end of the game,
+ * worked out backwards from the positions where the game is over by retrograde analysis: every
+ * position solved is taken back a move to the positions that lead to it, which each count down
+ * their moves until they are known to be lost (or win at once through a lost one), so every position
+ * only has its moves generated once.
+ *
+ * Tables are solved in order of fewer pieces, then fewer men, so that every table a move can lead
+ * out to (by jumping a piece or crowning a man) is solved before the tables that lead into it.
+ * Each table is solved by all the threads at once, each taking slices of its positions (or of the
+ * positions solved in the last wave) in turn.
+ *
+ * Usage: ./tbgen [pieces] [-threads count] [-dir directory]
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+
+// marks a position in a table being solved whose value isn't known yet
+static const uint8_t UNSOLVED = 254;
+
+// how many positions a thread takes at a time
+static const uint64_t SLICE_SIZE = 4096;
+
+// set on an event (see Generator::solve) that wins its position, rather than deciding one of its moves
+static const uint64_t WIN_EVENT = 1ull << 63;
+
+// a unique number for each material (which tables are kept under while they're needed)
+static int getMaterialNumber(const Material& material)
+{
+	return ((material.whiteMen * 16 + material.whiteKings) * 16 + material.blackMen) * 16 + material.blackKings;
+}
+
+static bool isSameMaterial(const Material& a, const Material& b)
+{
+	return getMaterialNumber(a) == getMaterialNumber(b);
+}
+
+/**
+ * @return Returns the value of a position where the game is over, or UNKNOWN if it isn't
+ * (the game ends as soon as either side can't move - see GameState - and the side
+ * that still can has won)
+ * @param position The position to look at
+ */
+static int getResult(const Position& position)
+{
+	bool canMove = position.hasMoves(position.isWhiteToMove());
+	bool opponentCanMove = position.hasMoves(!position.isWhiteToMove());
+
+	if (!canMove && !opponentCanMove)
+		return Tablebase::DRAW;
+	else if (!canMove)
+		return Tablebase::LOSS;
+	else if (!opponentCanMove)
+		return Tablebase::WIN;
+	return Tablebase::UNKNOWN;
+}
+
+/**
+ * Solves tables and remembers the solved ones for the tables that depend on them.
+ */
+class Generator
+{
+	public:
+		Generator(const std::string& directory, int threads) :
+			directory(directory), threads(threads), solved(16 * 16 * 16 * 16) {};
+
+		/**
+		 * Solves the table for some material and writes it to its file.
+		 * Every table a move can lead out to must already be solved.
+		 * @param material The material of the table
+		 */
+		void solve(const Material& material)
+		{
+			using namespace std;
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+			uint64_t size = Tablebase::getSize(material);
+			vector<uint8_t> codes(size, Tablebase::NO_POSITION);
+			vector<atomic<uint8_t>> remaining(size); // the moves of each unsolved position not yet known to lose
+
+			// first look at every position once: the ones where the game is over are solved, and the rest count
+			// their moves that stay in this table, and find out what their moves out of it (into tables solved
+			// before) decide, and at what distance (an "event", which is kept until that distance is reached)
+			vector<vector<uint64_t>> frontiers(threads);
+			vector<vector<vector<uint64_t>>> events(threads, vector<vector<uint64_t>>(Tablebase::MAX_DISTANCE + 1));
+			forEachSlice(size, [&](int worker, uint64_t begin, uint64_t end)
+			{
+				Position position;
+				for (uint64_t i = begin; i < end; i++)
+				{
+					if (!Tablebase::setPosition(material, i, position))
+						continue;
+
+					int result = getResult(position);
+					if (result != Tablebase::UNKNOWN)
+					{
+						codes[i] = Tablebase::encode(result, 0);
+						if (result != Tablebase::DRAW)
+							frontiers[worker].push_back(i);
+						continue;
+					}
+
+					int eventDistance;
+					bool wins;
+					codes[i] = UNSOLVED;
+					remaining[i] = countMoves(position, material, eventDistance, wins);
+					if (eventDistance >= 0)
+						events[worker][eventDistance].push_back(i | (wins ? WIN_EVENT : 0));
+				}
+			});
+			vector<uint64_t> frontier;
+			merge(frontiers, frontier);
+
+			// then go back one move at a time from the positions solved at each distance: a position is won
+			// as soon as one of its moves leads to a position lost for the opponent, and lost once every move
+			// leads to one won for the opponent, so each position is solved at the first distance it can be
+			// (past MAX_DISTANCE, distances are all stored as MAX_DISTANCE, so they are only the least they could be)
+			int waves = 0;
+			uint64_t capped = 0;
+			for (int distance = 0; ; distance++)
+			{
+				vector<uint64_t> distanceEvents;
+				if (distance <= Tablebase::MAX_DISTANCE)
+					for (int i = 0; i < threads; i++)
+						distanceEvents.insert(distanceEvents.end(), events[i][distance].begin(), events[i][distance].end());
+
+				bool eventsLeft = false;
+				for (int later = distance + 1; later <= Tablebase::MAX_DISTANCE && !eventsLeft; later++)
+					for (int i = 0; i < threads && !eventsLeft; i++)
+						eventsLeft = !events[i][later].empty();
+				if (frontier.empty() && distanceEvents.empty())
+				{
+					if (!eventsLeft)
+						break;
+					continue;
+				}
+
+				waves++;
+				uint8_t win = Tablebase::encode(Tablebase::WIN, distance + 1);
+				uint8_t loss = Tablebase::encode(Tablebase::LOSS, distance + 1);
+				auto claim = [&](uint64_t index, vector<uint64_t>& next)
+				{
+					if (remaining[index].exchange(0) != 0)
+					{
+						codes[index] = win;
+						next.push_back(index);
+					}
+				};
+				auto decide = [&](uint64_t index, vector<uint64_t>& next)
+				{
+					uint8_t count = remaining[index];
+					while (count != 0 && !remaining[index].compare_exchange_weak(count, count - 1))
+						;
+					if (count == 1)
+					{
+						codes[index] = loss;
+						next.push_back(index);
+					}
+				};
+
+				forEachSlice(frontier.size() + distanceEvents.size(), [&](int worker, uint64_t begin, uint64_t end)
+				{
+					Position position;
+					for (uint64_t i = begin; i < end; i++)
+					{
+						if (i >= frontier.size())
+						{
+							uint64_t event = distanceEvents[i - frontier.size()];
+							if (event & WIN_EVENT)
+								claim(event & ~WIN_EVENT, frontiers[worker]);
+							else
+								decide(event, frontiers[worker]);
+							continue;
+						}
+
+						// (the code is the opponent's, so their loss is a win for the position before)
+						Tablebase::setPosition(material, frontier[i], position);
+						bool lost = Tablebase::getValue(codes[frontier[i]]) == Tablebase::LOSS;
+						forEachPredecessor(position, [&](uint64_t index)
+						{
+							if (lost)
+								claim(index, frontiers[worker]);
+							else
+								decide(index, frontiers[worker]);
+						});
+					}
+				});
+				merge(frontiers, frontier);
+				if (distance + 1 > Tablebase::MAX_DISTANCE)
+					capped += frontier.size();
+			}
+
+			// anything still unsolved can never be forced either way
+			for (uint64_t i = 0; i < size; i++)
+				if (codes[i] == UNSOLVED)
+					codes[i] = Tablebase::encode(Tablebase::DRAW, 0);
+
+			size_t bytes = Tablebase::write(directory + "/" + Tablebase::getFileName(material), material, codes);
+
+			// report how it went, and remember the table for the ones that lead into it
+			uint64_t counts[Tablebase::UNKNOWN + 1] = {};
+			uint64_t positions = 0;
+			int longest = 0;
+			for (uint64_t i = 0; i < size; i++)
+			{
+				if (codes[i] == Tablebase::NO_POSITION)
+					continue;
+
+				positions++;
+				counts[Tablebase::getValue(codes[i])]++;
+				longest = max(longest, Tablebase::getDistance(codes[i]));
+			}
+			solved[getMaterialNumber(material)].swap(codes);
+			double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+			cout << Tablebase::getFileName(material) << ": " << positions << " positions, "
+			     << counts[Tablebase::WIN] << " won, " << counts[Tablebase::LOSS] << " lost, "
+			     << counts[Tablebase::DRAW] << " drawn, longest " << longest << " plies"
+			     << (capped > 0 ? " (" + to_string(capped) + " past the distance cap)" : "") << ", " << waves << " waves, "
+			     << bytes << " bytes, " << fixed << setprecision(2) << seconds << " seconds"
+			     << (bytes == 0 ? " (COULD NOT WRITE)" : "") << '\n';
+		}
+
+	private:
+		const std::string directory;
+		const int threads;
+		std::vector<std::vector<uint8_t>> solved;
+
+		/**
+		 * Runs a function over every number below a count, in slices that the threads take in turn.
+		 * @param count The number of numbers
+		 * @param function Called with the thread's number (0 up to the number of threads) and the first
+		 * number of a slice and the one after its last
+		 */
+		void forEachSlice(uint64_t count, const std::function<void(int, uint64_t, uint64_t)>& function) const
+		{
+			std::atomic<uint64_t> next(0);
+			auto work = [&](int worker)
+			{
+				for (uint64_t begin = next.fetch_add(SLICE_SIZE); begin < count; begin = next.fetch_add(SLICE_SIZE))
+					function(worker, begin, std::min(begin + SLICE_SIZE, count));
+			};
+
+			std::vector<std::thread> workers;
+			for (int i = 1; i < threads && i * SLICE_SIZE < count; i++)
+				workers.push_back(std::thread(work, i));
+			work(0);
+			for (size_t i = 0; i < workers.size(); i++)
+				workers[i].join();
+		}
+
+		/**
+		 * Moves what every thread found into one list, emptying theirs.
+		 * @param parts What each thread found
+		 * @param all Set to all of it
+		 */
+		static void merge(std::vector<std::vector<uint64_t>>& parts, std::vector<uint64_t>& all)
+		{
+			all.clear();
+			for (size_t i = 0; i < parts.size(); i++)
+			{
+				all.insert(all.end(), parts[i].begin(), parts[i].end());
+				parts[i].clear();
+			}
+		}
+
+		/**
+		 * Counts the moves of a position that stay in the table being solved, and looks up the ones that
+		 * lead out of it (jumps and crownings) in the tables solved before.
+		 * @param position The position (which must not be over)
+		 * @param material The material of the table being solved
+		 * @param eventDistance Set to the distance at which the moves out of the table decide something, or -1
+		 * if they never do: the shortest distance of one lost for the opponent, which wins this position one
+		 * ply later, or else the longest distance of them all if they are all won for the opponent
+		 * @param wins Set to true if the moves out of the table win this position
+		 * @return Returns the number of moves not yet known to lose: those that stay in the table, plus one
+		 * for all the moves out of it, if there are any
+		 */
+		uint8_t countMoves(Position& position, const Material& material, int& eventDistance, bool& wins) const
+		{
+			MoveList moves;
+			position.getMoves(moves);
+
+			int count = 0, shortestLoss = -1, longestWin = -1;
+			bool leaves = false, draws = false;
+			for (unsigned int i = 0; i < moves.size(); i++)
+			{
+				UndoRecord undo;
+				position.makeMove(moves[i], undo);
+				Material childMaterial = Tablebase::getMaterial(position);
+				if (isSameMaterial(childMaterial, material))
+					count++;
+				else
+				{
+					// the code is the opponent's, so their loss is our win
+					leaves = true;
+					uint8_t code = getCode(position, childMaterial);
+					int distance = Tablebase::getDistance(code);
+					if (Tablebase::getValue(code) == Tablebase::LOSS)
+						shortestLoss = shortestLoss < 0 ? distance : std::min(shortestLoss, distance);
+					else if (Tablebase::getValue(code) == Tablebase::WIN)
+						longestWin = std::max(longestWin, distance);
+					else
+						draws = true;
+				}
+				position.unmakeMove(undo);
+			}
+
+			wins = shortestLoss >= 0;
+			eventDistance = wins ? shortestLoss : draws ? -1 : longestWin;
+			return (uint8_t)(count + (leaves ? 1 : 0));
+		}
+
+		/**
+		 * Calls a function with the index of every position in the table being solved that has a move leading
+		 * to the given one: a move by the side that isn't to move in it, which neither jumps nor crowns
+		 * (or it would lead out of the table), from a position where that side couldn't have jumped instead.
+		 * @param position The position
+		 * @param function The function
+		 */
+		template<typename Function>
+		static void forEachPredecessor(const Position& position, Function function)
+		{
+			bool isWhite = !position.isWhiteToMove();
+			bitboard_t pieces = position.getPieces(isWhite);
+			bitboard_t empty = position.getEmptySquares();
+
+			for (int direction = Position::UP_LEFT; direction <= Position::DOWN_RIGHT; direction++)
+			{
+				// (kings move every way, but white men only down and black men only up)
+				bool isForward = (direction == Position::DOWN_LEFT || direction == Position::DOWN_RIGHT) == isWhite;
+				bitboard_t movers = isForward ? pieces : pieces & position.getKings();
+				while (movers)
+				{
+					// the piece came from the other end of the enum's direction
+					int to = Position::popSquare(movers);
+					bitboard_t from = Position::shift(1u << to, Position::DOWN_RIGHT - direction) & empty;
+					if (!from)
+						continue;
+
+					Position previous = position;
+					bool isKing = (position.getKings() & (1u << to)) != 0;
+					previous.clearSquare(to);
+					previous.setPiece(Position::popSquare(from), isWhite, isKing);
+					previous.setWhiteToMove(isWhite);
+					if (previous.getJumpingPieces(isWhite) == 0)
+						function(Tablebase::getIndex(previous));
+				}
+			}
+		}
+
+		/**
+		 * @return Returns the code of a position in a table solved before the one being solved
+		 * (or of one where the game is over, which may have no table)
+		 * @param position The position
+		 * @param material Its material
+		 */
+		uint8_t getCode(const Position& position, const Material& material) const
+		{
+			int result = getResult(position);
+			if (result != Tablebase::UNKNOWN)
+				return Tablebase::encode(result, 0);
+			return solved[getMaterialNumber(material)][Tablebase::getIndex(position)];
+		}
+};
+
+int main(int argc, char* argv[])
+{
+	using namespace std;
+
+	int pieces = 4;
+	int threads = (int)thread::hardware_concurrency();
+	string directory = "tablebases";
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc)
+			threads = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-dir") == 0 && i + 1 < argc)
+			directory = argv[++i];
+		else
+			pieces = atoi(argv[i]);
+	}
+	if (threads < 1)
+		threads = 1;
+	if (pieces < 2 || pieces > Tablebase::MAX_PIECES)
+	{
+		cout << "The number of pieces must be between 2 and " << Tablebase::MAX_PIECES << '\n';
+		return 1;
+	}
+
+	mkdir(directory.c_str(), 0755);
+
+	// every material with pieces on both sides, in the order they have to be solved in
+	vector<Material> materials;
+	for (int whiteMen = 0; whiteMen <= pieces; whiteMen++)
+		for (int whiteKings = 0; whiteKings <= pieces; whiteKings++)
+			for (int blackMen = 0; blackMen <= pieces; blackMen++)
+				for (int blackKings = 0; blackKings <= pieces; blackKings++)
+				{
+					Material material = { whiteMen, whiteKings, blackMen, blackKings };
+					if (material.getTotal() <= pieces && Tablebase::isIndexable(material))
+						materials.push_back(material);
+				}
+
+	auto getLevel = [](const Material& material)
+	{ return material.getTotal() * 100 + material.whiteMen + material.blackMen; };
+	stable_sort(materials.begin(), materials.end(), [&](const Material& a, const Material& b)
+	{ return getLevel(a) < getLevel(b); });
+
+	Generator generator(directory, threads);
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	for (size_t i = 0; i < materials.size(); i++)
+		generator.solve(materials[i]);
+
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	cout << "Solved " << materials.size() << " tables in " << fixed << setprecision(2) << seconds << " seconds\n";
+	return 0;
+}
@@ -0,0 +1,404 @@
+#include "Evaluator.h"
+#include "MappedFile.h"
+#include "PdnReader.h"
+#include "Position.h"
+#include "Move.h"
+#include "Typedefs.h"
+
+#include <vector>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * File responsible for tuning the evaluation's weights (see Evaluator.h) to how games actually ended.
+ *
+ * Positions are read along with the result of their game, either from a file with a position on each
+ * line in FEN followed by the result ("1-0" if White won, "0-1" if Black won, "1/2-1/2" for a draw, as
+ * written by selfplay -positions), or as every position of every game in a PDN archive (see PdnReader.h).
+ * Positions where the side to move has a jump are left out, since how they turn out depends on the jump
+ * rather than on anything the evaluation sees. Each position is kept only as the engine's own features
+ * (see Evaluator::getFeatures), a byte each, so millions of positions fit in a few tens of megabytes.
+ *
+ * The weights are then fit by gradient descent on the logistic loss of predicting each result from the
+ * evaluation (as the probability of White winning, 1 / (1 + e^(-scale * evaluation))), with the positions
+ * split between threads for every step. The scale is first chosen to best fit the weights being started
+ * from, which then keeps the weights in the same units. The tuned weights are written to the file the
+ * engine reads at startup.
+ *
+ * Usage: ./tune [-positions file] [-pdn file] [-skip plies] [-iterations count] [-rate step] [-threads count]
+ *        [-weights file] [-out file]
+ *
+ * @author Mckenna Cisler
+ * @version 10.16.2026
+ */
+
+static const int FEATURES = Evaluator::FEATURES;
+
+// the number of positions whose evaluations are worked out together (so each feature is a run of bytes)
+static const size_t BLOCK_SIZE = 256;
+
+// the number of sums the gradient of a block is split between, so they can be added up side by side
+static const size_t LANES = 16;
+
+/**
+ * The positions to tune to, stored a feature at a time: every position's count of the first feature,
+ * then of the second, and so on, so a block of positions can be scored with one pass over each.
+ * The counts are padded with zeros to a whole number of blocks.
+ */
+struct DataSet
+{
+	std::vector<int8_t> features[FEATURES];
+	std::vector<uint8_t> results; // for White, in half points (0 for a loss, 1 for a draw and 2 for a win)
+
+	size_t size() const { return results.size(); }
+
+	/**
+	 * Adds a position, unless the side to move has a jump.
+	 * @param position The position
+	 * @param result The result of its game for White, in half points
+	 * @return Returns true if the position was added
+	 */
+	bool add(const Position& position, int result)
+	{
+		if (position.getJumpingPieces(position.isWhiteToMove()))
+			return false;
+
+		int counts[FEATURES];
+		Evaluator::getFeatures(position, counts);
+		for (int feature = 0; feature < FEATURES; feature++)
+		{
+			if (features[feature].size() == size())
+				features[feature].resize(size() + BLOCK_SIZE, 0);
+			features[feature][size()] = (int8_t)counts[feature];
+		}
+		results.push_back((uint8_t)result);
+		return true;
+	}
+};
+
+/**
+ * Reads positions and their results, a line each, from a file.
+ * @param path The file
+ * @param data The positions to add them to
+ * @return Returns the number of lines that weren't a position and result, or -1 if the file can't be read
+ */
+static long long readPositions(const std::string& path, DataSet& data)
+{
+	MappedFile file;
+	if (!file.open(path))
+		return -1;
+
+	const char* at = reinterpret_cast<const char*>(file.getData());
+	const char* end = at + file.getSize();
+	long long invalid = 0;
+	while (at < end)
+	{
+		const char* lineEnd = static_cast<const char*>(std::memchr(at, '\n', end - at));
+		if (lineEnd == nullptr)
+			lineEnd = end;
+
+		// the result is the last word, after the FEN
+		const char* wordEnd = lineEnd;
+		while (wordEnd > at && (wordEnd[-1] == '\r' || wordEnd[-1] == ' '))
+			wordEnd--;
+		const char* word = wordEnd;
+		while (word > at && word[-1] != ' ')
+			word--;
+
+		size_t length = wordEnd - word;
+		int result = length == 3 && std::memcmp(word, "1-0", 3) == 0 ? 2
+		           : length == 3 && std::memcmp(word, "0-1", 3) == 0 ? 0
+		           : length == 7 && std::memcmp(word, "1/2-1/2", 7) == 0 ? 1 : -1;
+
+		Position position;
+		if (word > at && result >= 0 && position.setFromFen(at, word - at))
+			data.add(position, result);
+		else if (wordEnd > at)
+			invalid++;
+
+		at = lineEnd + 1;
+	}
+	return invalid;
+}
+
+/**
+ * Adds up the logistic loss of predicting the results of a range of positions, or instead its gradient
+ * (which is all a step of the descent needs, and saves working out two logarithms per position).
+ * @param data The positions
+ * @param first The first position of the range (at the start of a block)
+ * @param last The position after the last one of the range
+ * @param weights The weight of each feature
+ * @param scale What the evaluation is multiplied by before it is turned into a probability
+ * @param gradient Added to with how much the loss changes with each weight, instead of adding up the loss
+ * (if not null)
+ * @return Returns the total loss of the range (or 0 if the gradient was asked for)
+ */
+static double addLoss(const DataSet& data, size_t first, size_t last, const double weights[FEATURES], double scale,
+                      double* gradient)
+{
+	float floatWeights[FEATURES];
+	for (int feature = 0; feature < FEATURES; feature++)
+		floatWeights[feature] = (float)weights[feature];
+	float floatScale = (float)scale;
+
+	double loss = 0;
+	for (size_t start = first; start < last; start += BLOCK_SIZE)
+	{
+		size_t count = std::min(BLOCK_SIZE, last - start);
+
+		// evaluate the whole block at once, a feature at a time (which the compiler turns into vector
+		// instructions, as the loops always run the same number of times)
+		float evaluations[BLOCK_SIZE] = {};
+		for (int feature = 0; feature < FEATURES; feature++)
+		{
+			const int8_t* counts = &data.features[feature][start];
+			float weight = floatWeights[feature];
+			for (size_t i = 0; i < BLOCK_SIZE; i++)
+				evaluations[i] += weight * counts[i];
+		}
+
+		// then how far each prediction is from the result (with nothing for the padding)
+		float errors[BLOCK_SIZE] = {};
+		for (size_t i = 0; i < count; i++)
+		{
+			float prediction = 1 / (1 + std::exp(-floatScale * evaluations[i]));
+			prediction = std::min(std::max(prediction, 1e-7f), 1 - 1e-7f);
+			float result = data.results[start + i] / 2.0f;
+
+			if (gradient == nullptr)
+				loss -= result * std::log(prediction) + (1 - result) * std::log(1 - prediction);
+			errors[i] = (prediction - result) * floatScale;
+		}
+
+		if (gradient == nullptr)
+			continue;
+		for (int feature = 0; feature < FEATURES; feature++)
+		{
+			const int8_t* counts = &data.features[feature][start];
+			float sums[LANES] = {};
+			for (size_t i = 0; i < BLOCK_SIZE; i += LANES)
+			{
+				for (size_t lane = 0; lane < LANES; lane++)
+					sums[lane] += errors[i + lane] * counts[i + lane];
+			}
+			for (size_t lane = 0; lane < LANES; lane++)
+				gradient[feature] += sums[lane];
+		}
+	}
+	return loss;
+}
+
+/**
+ * Works out the average logistic loss of predicting every result, or instead its gradient, on several threads.
+ * @param data The positions
+ * @param weights The weight of each feature
+ * @param scale What the evaluation is multiplied by before it is turned into a probability
+ * @param threads The number of threads to split the positions between
+ * @param gradient Set to the average gradient of the loss with respect to each weight, instead of working out
+ * the loss (if not null)
+ * @return Returns the average loss (or 0 if the gradient was asked for)
+ */
+static double getLoss(const DataSet& data, const double weights[FEATURES], double scale, int threads,
+                      double* gradient)
+{
+	// every thread gets a whole number of blocks, and its own loss and gradient to add up
+	size_t blocks = (data.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	std::vector<double> losses(threads, 0);
+	std::vector<double> gradients(threads * FEATURES, 0);
+	std::vector<std::thread> workers;
+
+	for (int thread = 0; thread < threads; thread++)
+	{
+		size_t first = std::min(data.size(), blocks * thread / threads * BLOCK_SIZE);
+		size_t last = std::min(data.size(), blocks * (thread + 1) / threads * BLOCK_SIZE);
+		double* threadGradient = gradient != nullptr ? &gradients[thread * FEATURES] : nullptr;
+
+		auto work = [&, thread, first, last, threadGradient]()
+		{ losses[thread] = addLoss(data, first, last, weights, scale, threadGradient); };
+		if (thread + 1 < threads)
+			workers.push_back(std::thread(work));
+		else
+			work();
+	}
+	for (unsigned int i = 0; i < workers.size(); i++)
+		workers[i].join();
+
+	double loss = 0;
+	for (int thread = 0; thread < threads; thread++)
+		loss += losses[thread];
+
+	if (gradient != nullptr)
+	{
+		for (int feature = 0; feature < FEATURES; feature++)
+		{
+			gradient[feature] = 0;
+			for (int thread = 0; thread < threads; thread++)
+				gradient[feature] += gradients[thread * FEATURES + feature];
+			gradient[feature] /= data.size();
+		}
+	}
+	return loss / data.size();
+}
+
+/**
+ * Finds the scale that makes the given weights best predict the results.
+ * @return Returns the scale
+ */
+static double findScale(const DataSet& data, const double weights[FEATURES], int threads)
+{
+	// the loss has a single minimum, so narrow in on it (on a log scale, since it could be anywhere)
+	double low = std::log(1e-5), high = std::log(1.0);
+	for (int step = 0; step < 40; step++)
+	{
+		double third = (high - low) / 3;
+		if (getLoss(data, weights, std::exp(low + third), threads, nullptr) <
+		    getLoss(data, weights, std::exp(high - third), threads, nullptr))
+			high -= third;
+		else
+			low += third;
+	}
+	return std::exp((low + high) / 2);
+}
+
+int main(int argc, char* argv[])
+{
+	using namespace std;
+
+	string positionsFile;
+	string pdnFile;
+	string weightsFile = Evaluator::DEFAULT_WEIGHTS_FILE;
+	string outFile = Evaluator::DEFAULT_WEIGHTS_FILE;
+	int skip = 8;
+	int iterations = 1000;
+	double rate = 0.5;
+	int threads = (int)thread::hardware_concurrency();
+
+	for (int i = 1; i + 1 < argc; i++)
+	{
+		if (strcmp(argv[i], "-positions") == 0)
+			positionsFile = argv[++i];
+		else if (strcmp(argv[i], "-pdn") == 0)
+			pdnFile = argv[++i];
+		else if (strcmp(argv[i], "-skip") == 0)
+			skip = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-iterations") == 0)
+			iterations = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-rate") == 0)
+			rate = atof(argv[++i]);
+		else if (strcmp(argv[i], "-threads") == 0)
+			threads = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-weights") == 0)
+			weightsFile = argv[++i];
+		else if (strcmp(argv[i], "-out") == 0)
+			outFile = argv[++i];
+		else
+		{
+			cout << "Unknown option: " << argv[i] << '\n';
+			return 1;
+		}
+	}
+	if (threads < 1)
+		threads = 1;
+
+	// start from the weights the engine would use (before any positions are set up, see Evaluator::setWeights)
+	Evaluator::loadWeights(weightsFile);
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	DataSet data;
+	if (!positionsFile.empty())
+	{
+		long long invalid = readPositions(positionsFile, data);
+		if (invalid < 0)
+		{
+			cout << "Could not read " << positionsFile << '\n';
+			return 1;
+		}
+		if (invalid > 0)
+			cout << "Skipped " << invalid << " lines of " << positionsFile << " that weren't a position and result\n";
+	}
+	if (!pdnFile.empty())
+	{
+		PdnReader reader;
+		if (!reader.open(pdnFile))
+		{
+			cout << "Could not read " << pdnFile << '\n';
+			return 1;
+		}
+
+		reader.read([&](const Position& position, const Move&, int result, int ply)
+		{
+			if (ply >= skip && result != PdnReader::UNKNOWN)
+				data.add(position, result == PdnReader::WHITE_WIN ? 2 : result == PdnReader::DRAW ? 1 : 0);
+		});
+		cout << "Read " << reader.getGames() << " games (" << reader.getErrors() << " with illegal moves)\n";
+	}
+	if (data.size() == 0)
+	{
+		cout << "Usage: ./tune [-positions file] [-pdn file] [-skip plies] [-iterations count] [-rate step] "
+		     << "[-threads count] [-weights file] [-out file]\n";
+		return 1;
+	}
+
+	double weights[FEATURES];
+	for (int feature = 0; feature < FEATURES; feature++)
+		weights[feature] = Evaluator::getWeight(feature);
+
+	cout << "Loaded " << data.size() << " quiet positions in " << fixed << setprecision(2)
+	     << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " seconds\n";
+	double scale = findScale(data, weights, threads);
+	cout << "Scale " << setprecision(6) << scale << ", loss " << getLoss(data, weights, scale, threads, nullptr) << '\n';
+
+	// gradient descent, with each weight's step sized by the running averages of its gradient (Adam),
+	// since some features are counted far more often than others
+	const double BETA1 = 0.9, BETA2 = 0.999, EPSILON = 1e-12;
+	double moments[FEATURES] = {}, squares[FEATURES] = {};
+	start = chrono::steady_clock::now();
+	for (int iteration = 1; iteration <= iterations; iteration++)
+	{
+		double gradient[FEATURES];
+		getLoss(data, weights, scale, threads, gradient);
+
+		for (int feature = 0; feature < FEATURES; feature++)
+		{
+			moments[feature] = BETA1 * moments[feature] + (1 - BETA1) * gradient[feature];
+			squares[feature] = BETA2 * squares[feature] + (1 - BETA2) * gradient[feature] * gradient[feature];
+			double moment = moments[feature] / (1 - pow(BETA1, iteration));
+			double square = squares[feature] / (1 - pow(BETA2, iteration));
+			weights[feature] -= rate * moment / (sqrt(square) + EPSILON);
+		}
+
+		if (iteration % 100 == 0 || iteration == iterations)
+			cout << "Iteration " << iteration << ": loss " << setprecision(6)
+			     << getLoss(data, weights, scale, threads, nullptr) << endl;
+	}
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	// the engine's weights are whole numbers
+	int tuned[FEATURES];
+	for (int feature = 0; feature < FEATURES; feature++)
+	{
+		tuned[feature] = (int)lround(weights[feature]);
+		weights[feature] = tuned[feature];
+	}
+	Evaluator::setWeights(tuned);
+
+	cout << "Tuned in " << setprecision(2) << seconds << " seconds (" << setprecision(1)
+	     << seconds * 1e9 / ((double)iterations * data.size()) << " ns per position per iteration), loss "
+	     << setprecision(6) << getLoss(data, weights, scale, threads, nullptr) << ":\n";
+	for (int feature = 0; feature < FEATURES; feature++)
+		cout << "  " << Evaluator::FEATURE_NAMES[feature] << ' ' << tuned[feature] << '\n';
+
+	if (!Evaluator::saveWeights(outFile))
+	{
+		cout << "Could not write " << outFile << '\n';
+		return 1;
+	}
+	cout << "Wrote " << outFile << '\n';
+	return 0;
+}